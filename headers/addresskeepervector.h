@@ -12,7 +12,7 @@ public:
   /**
    * \brief This is the default AddressKeeperVector constructor
    */
-  AddressKeeperVector() { size = 0; v = 0; };
+  AddressKeeperVector() { size = 0; capacity = 0; v = 0; };
   /**
    * \brief This is the AddressKeeperVector destructor
    * \note This will free all the memory allocated to all the elements of the vector
@@ -21,12 +21,13 @@ public:
   /**
    * \brief This will add one new empty entry to the vector
    * \note The new element of the vector will be created, and set to zero
+   * \note The memory allocated to the vector is doubled when it is full, so that adding entries one at a time to a long vector does not copy the vector each time
    */
   void resize();
   /**
    * \brief This will delete an entry from the vector
    * \param pos is the element of the vector to be deleted
-   * \note This will free the memory allocated to the deleted element of the vector
+   * \note The memory allocated to the vector is kept, so that it can be used by new entries
    */
   void Delete(int pos);
   /**
@@ -55,6 +56,10 @@ protected:
    * \brief This is the size of the vector
    */
   int size;
+  /**
+   * \brief This is the number of entries that the memory allocated to the vector can hold
+   */
+  int capacity;
 };
 
 #endif
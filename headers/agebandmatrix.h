@@ -108,6 +108,11 @@ public:
    * \brief This function will set the population stored in the vector to zero
    */
   void setToZero();
+  /**
+   * \brief This function will calculate the mean weight of the population stored in the vector once the population has been summed
+   * \note While the population is being summed the vector stores the total biomass instead of the mean weight
+   */
+  void finaliseSum();
   /**
    * \brief This function will increase the age of the population stored in the vector to zero
    */
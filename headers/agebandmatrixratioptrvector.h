@@ -9,6 +9,7 @@
 #include "agebandmatrixptrvector.h"
 #include "agebandmatrixratio.h"
 #include "charptrvector.h"
+#include "doublematrix.h"
 #include "gadget.h"
 
 class Maturity;
@@ -40,6 +41,8 @@ protected:
   AgeBandMatrixRatio** v;
   CharPtrVector tagID;
   DoubleVector tagLoss;
+  CharPtrVector storeID;
+  DoubleMatrix tagStore;
 };
 
 #endif
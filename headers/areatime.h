@@ -185,6 +185,15 @@ public:
    * \return number of substeps
    */
   int numSubSteps() const { return numsubsteps[currentstep - 1]; };
+  /**
+   * \brief This is the function that removes the substeps from every timestep, used for the model without substeps
+   */
+  void removeSubSteps();
+  /**
+   * \brief This function will check whether any of the timesteps are split into substeps
+   * \return 1 if there is a timestep with more than one substep, 0 otherwise
+   */
+  int hasSubSteps() const;
   /**
    * \brief This is the function that increases the substep within the current timestep
    */
@@ -194,6 +203,16 @@ public:
    * \return 1 if the length of the timestep has changed, 0 otherwise
    */
   int didStepSizeChange() const;
+  /**
+   * \brief This is the function that will check to see if the values of the parameters could have changed since the previous timestep
+   * \return 1 if this is the first timestep or the parameters have been changed part way through the simulation, 0 otherwise
+   */
+  int didParametersChange() const { return ((this->getTime() == 1) || (paramchanged)); };
+  /**
+   * \brief This is the function that will note that the values of the parameters have been changed part way through the simulation
+   * \note This only applies to the current timestep, so that anything calculated from the parameters is recalculated on this timestep
+   */
+  void setParametersChanged() { paramchanged = 1; };
   /**
    * \brief This function will return the maximum ratio of any stock that can be consumed on the current substep
    * \return maximum ratio of the stock that can be consumed on the current substep
@@ -246,6 +265,10 @@ protected:
    * \brief This is the IntVector of substeps in each step
    */
   IntVector numsubsteps;
+  /**
+   * \brief This is the flag used to denote whether the parameters have been changed part way through the simulation on the current timestep
+   */
+  int paramchanged;
   /**
    * \brief This is the current substep of the model simulation
    */
@@ -54,6 +54,11 @@ public:
    * \note keeper can adjust the value of the parameters to ensure that they are within the bounds
    */
   virtual void addLikelihoodKeeper(const TimeClass* const TimeInfo, Keeper* const keeper);
+  /**
+   * \brief This function will move any parameters that are outside the bounds back to the bounds, without calculating the likelihood score
+   * \param keeper is the Keeper for the current model
+   */
+  void resetValues(Keeper* const keeper);
   /**
    * \brief This function will print the summary MigrationPenalty likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
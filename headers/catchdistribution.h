@@ -192,6 +192,10 @@ private:
    * \brief This is the index of the timesteps for the likelihood component data
    */
   int timeindex;
+  /**
+   * \brief This is the index of the timesteps for the model data, which is only stored for each timestep if the likelihood information is printed
+   */
+  int modelindex;
   /**
    * \brief This ActionAtTimes stores information about when the likelihood score should be calculated
    */
@@ -248,11 +252,23 @@ private:
    * \note This is set to zero, and not used, if the multivariate normal function is not used
    */
   LUDecomposition LU;
+  /**
+   * \brief This is the DoubleMatrix used to temporarily store the correlation matrix, if the multivariate normal function has been selected
+   */
+  DoubleMatrix correlation;
   /**
    * \brief This is the Multinomial that can be used when calculating the likelihood score, if the multinomial function has been selected
    * \note This is set to zero, and not used, if the multinomial function is not used
    */
   Multinomial MN;
+  /**
+   * \brief This is the DoubleVector used to temporarily store the observed data when calculating the likelihood score
+   */
+  DoubleVector datavec;
+  /**
+   * \brief This is the DoubleVector used to temporarily store the modelled data when calculating the likelihood score
+   */
+  DoubleVector modelvec;
   /**
    * \brief This is the AgeBandMatrixPtrVector used to temporarily store the information returned from the aggregatation function
    * \note The indices for this object are [area][age][length]
@@ -157,6 +157,10 @@ private:
    * \brief This is the index of the timesteps for the likelihood component data
    */
   int timeindex;
+  /**
+   * \brief This is the index of the timesteps for the model data, which is only stored for each timestep if the likelihood information is printed
+   */
+  int modelindex;
   /**
    * \brief This is the identifier of the function to be used to calculate the likelihood component
    */
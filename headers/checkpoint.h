@@ -0,0 +1,148 @@
+#ifndef checkpoint_h
+#define checkpoint_h
+
+#include "doublematrix.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "parametervector.h"
+#include "gadget.h"
+
+/**
+ * \class Checkpoint
+ * \brief This is the class used to save the state of an optimising run to a binary file, so that the optimisation can be continued from that point if the run is stopped
+ *
+ * The state of the optimisation is saved at regular intervals, based on the number of function evaluations, when the optimisation algorithms reach the start of one of their iterations.  The file contains the values of the model parameters, the best point found so far and the internal state of the optimisation algorithm that is currently running.  The file is first written to a temporary file and then renamed, so that a valid file is always available even if Gadget is stopped while the state is being saved.
+ */
+class Checkpoint {
+public:
+  /**
+   * \brief This is the Checkpoint constructor
+   * \param filename is the name of the file that the state of the optimisation will be saved to
+   * \param numiter is the number of function evaluations between saving the state of the optimisation
+   * \param switches is the ParameterVector of the names of the model parameters
+   * \param numopt is the number of optimisation algorithms that will be used
+   */
+  Checkpoint(const char* const filename, int numiter, const ParameterVector& switches, int numopt);
+  /**
+   * \brief This is the default Checkpoint destructor
+   */
+  ~Checkpoint();
+  /**
+   * \brief This function will check whether the state of the optimisation should be saved
+   * \param funceval is the current number of function evaluations
+   * \return 1 if the state should be saved, 0 otherwise
+   */
+  int isDue(int funceval) const { return ((interval > 0) && (funceval - lasteval >= interval)); };
+  /**
+   * \brief This function will return the flag used to denote whether the state of the optimisation is being restored
+   * \return flag
+   */
+  int isResuming() const { return resuming; };
+  /**
+   * \brief This function will open the temporary file to save the state of the optimisation to
+   * \param funceval is the current number of function evaluations
+   */
+  void openWrite(int funceval);
+  /**
+   * \brief This function will close the temporary file and replace the previously saved file
+   */
+  void closeWrite();
+  /**
+   * \brief This function will open a file to restore the state of the optimisation from, if the file exists
+   * \param filename is the name of the file
+   */
+  void openRead(const char* const filename);
+  /**
+   * \brief This function will close the file that the state of the optimisation has been restored from
+   * \param funceval is the number of function evaluations that had been done when the state was saved
+   */
+  void closeRead(int funceval);
+  /**
+   * \brief This function will write an integer to the file
+   * \param value is the value to be written
+   */
+  void write(int value);
+  /**
+   * \brief This function will write a double to the file
+   * \param value is the value to be written
+   */
+  void write(double value);
+  /**
+   * \brief This function will write an IntVector to the file
+   * \param vec is the IntVector to be written
+   */
+  void write(const IntVector& vec);
+  /**
+   * \brief This function will write a DoubleVector to the file
+   * \param vec is the DoubleVector to be written
+   */
+  void write(const DoubleVector& vec);
+  /**
+   * \brief This function will write a DoubleMatrix to the file
+   * \param mat is the DoubleMatrix to be written
+   */
+  void write(const DoubleMatrix& mat);
+  /**
+   * \brief This function will read an integer from the file
+   * \param value is the value to be read
+   */
+  void read(int& value);
+  /**
+   * \brief This function will read a double from the file
+   * \param value is the value to be read
+   */
+  void read(double& value);
+  /**
+   * \brief This function will read an IntVector from the file
+   * \param vec is the IntVector to be read
+   * \note The IntVector must already have the correct size
+   */
+  void read(IntVector& vec);
+  /**
+   * \brief This function will read a DoubleVector from the file
+   * \param vec is the DoubleVector to be read
+   * \note The DoubleVector must already have the correct size
+   */
+  void read(DoubleVector& vec);
+  /**
+   * \brief This function will read a DoubleMatrix from the file
+   * \param mat is the DoubleMatrix to be read
+   * \note The DoubleMatrix must already have the correct size
+   */
+  void read(DoubleMatrix& mat);
+private:
+  /**
+   * \brief This is the name of the file that the state of the optimisation will be saved to
+   */
+  char* checkfile;
+  /**
+   * \brief This is the name of the temporary file used while the state of the optimisation is being saved
+   */
+  char* tmpfile;
+  /**
+   * \brief This is the number of function evaluations between saving the state of the optimisation
+   */
+  int interval;
+  /**
+   * \brief This is the number of function evaluations when the state of the optimisation was last saved
+   */
+  int lasteval;
+  /**
+   * \brief This is the flag used to denote whether the state of the optimisation is being restored
+   */
+  int resuming;
+  /**
+   * \brief This is the hash value calculated from the names of the switches and the number of optimisation algorithms, used to check files that are read in
+   */
+  unsigned int signature;
+  /**
+   * \brief This is the ofstream that the state of the optimisation is written to
+   */
+  ofstream outfile;
+  /**
+   * \brief This is the ifstream that the state of the optimisation is read from
+   */
+  ifstream infile;
+};
+
+#endif
@@ -77,6 +77,34 @@ public:
    * \return maxpos for coarser length group i
    */
   int maxPos(int i) const { return maxpos[i]; };
+  /**
+   * \brief This function will return the index in the source length group for an entry in the conversion map
+   * \param i is the index in the finer length group
+   * \return from for finer length group i
+   */
+  int getFrom(int i) const { return from[i]; };
+  /**
+   * \brief This function will return the index in the target length group for an entry in the conversion map
+   * \param i is the index in the finer length group
+   * \return to for finer length group i
+   */
+  int getTo(int i) const { return to[i]; };
+  /**
+   * \brief This function will return the proportion of the source length group that is added to the target length group for an entry in the conversion map
+   * \param i is the index in the finer length group
+   * \return weight for finer length group i
+   */
+  double getWeight(int i) const { return weight[i]; };
+  /**
+   * \brief This function will find the entries in the conversion map that convert between part of the source length group and part of the target length group
+   * \param mint is the minimum index in the target length group
+   * \param maxt is the maximum index in the target length group
+   * \param mins is the minimum index in the source length group
+   * \param maxs is the maximum index in the source length group
+   * \param first will contain the first entry in the conversion map that is needed
+   * \param last will contain the entry after the last entry in the conversion map that is needed
+   */
+  void getRange(int mint, int maxt, int mins, int maxs, int& first, int& last) const;
   /**
    * \brief This function will interpolate values defined for a coarser length division onto a finer length division
    * \param Vf is the DoubleVector that will contain the finer values after the interpolation
@@ -132,6 +160,21 @@ protected:
    * \note This vector is resized to be the same length as the coarser LengthGroupDivision object
    */
   IntVector maxpos;
+  /**
+   * \brief This is the IntVector of the index in the source length group for each entry in the conversion map
+   * \note This vector is resized to be the same length as the finer LengthGroupDivision object, so that there is one entry in the conversion map for each finer length group
+   */
+  IntVector from;
+  /**
+   * \brief This is the IntVector of the index in the target length group for each entry in the conversion map
+   * \note This vector is resized to be the same length as the finer LengthGroupDivision object
+   */
+  IntVector to;
+  /**
+   * \brief This is the DoubleVector of the proportion of the source length group that is added to the target length group for each entry in the conversion map
+   * \note This vector is resized to be the same length as the finer LengthGroupDivision object
+   */
+  DoubleVector weight;
   /**
    * \brief This is the DoubleVector of the ratios used when interpolating between the length groups
    * \note This vector is resized to be the same length as the finer LengthGroupDivision object and is only used if the interpolate flag has been set
@@ -19,6 +19,9 @@
 #include "maininfo.h"
 #include "printinfo.h"
 #include "optinfo.h"
+#include "likelihoodcache.h"
+#include "checkpoint.h"
+#include "statusblock.h"
 #include "gadget.h"
 
 /**
@@ -36,8 +39,10 @@ public:
   /**
    * \brief This is the Ecosystem constructor specifying details about the model
    * \param main is the MainInfo specifying the command line options for the model run
+   * \param nosubsteps is the flag to denote whether a version of the model without substeps should be created (default 0, full model)
+   * \note The version of the model without substeps doesn't print any output, and is used to find a starting point for the optimisation of the full model
    */
-  Ecosystem(const MainInfo& main);
+  Ecosystem(const MainInfo& main, int nosubsteps = 0);
   /**
    * \brief This is the default Ecosystem destructor
    */
@@ -46,8 +51,9 @@ public:
    * \brief This function will read the model data from the main input file
    * \param infile is the CommentStream to read the likelihood data from
    * \param main is the MainInfo specifying the command line options for the model run
+   * \param nosubsteps is the flag to denote whether the version of the model without substeps should be read
    */
-  void readMain(CommentStream& infile, const MainInfo& main);
+  void readMain(CommentStream& infile, const MainInfo& main, int nosubsteps);
   /**
    * \brief This function will read the likelihood data from the input file
    * \param infile is the CommentStream to read the likelihood data from
@@ -124,6 +130,21 @@ public:
    * \param Stochastic is the StochasticData containing the new values of the parameters
    */
   void Update(const StochasticData* const Stochastic) const { keeper->Update(Stochastic); };
+  /**
+   * \brief This function will update the Ecosystem parameters with new values
+   * \param val is the DoubleVector containing the new values of all the parameters
+   */
+  void Update(const DoubleVector& val) const { keeper->Update(val); };
+  /**
+   * \brief This function will return the values of all the parameters at the best point found during the optimisation
+   * \param val is the DoubleVector that will contain the values of the parameters
+   */
+  void getBestValues(DoubleVector& val) const { keeper->getBestValues(val); };
+  /**
+   * \brief This function will return the names of all the parameters
+   * \param sw is the ParameterVector that will contain the names of the parameters
+   */
+  void getSwitches(ParameterVector& sw) const { keeper->getSwitches(sw); };
   /**
    * \brief This function will reset the Ecosystem information
    */
@@ -182,6 +203,14 @@ public:
    * \note This function covers a single running of the model, calculating the population structure and also calculating the likelihood score obtained from comparing the modelled population to the data specified in the likelihood components
    */
   void Simulate(int print);
+  /**
+   * \brief This function will simulate the population in the model, and then simulate a number of projection scenarios from the state of the model at the start of the projection
+   * \param data is the StochasticData containing the values of the parameters for each scenario
+   * \param year is the first year of the projection
+   * \param print is the flag to denote whether the model output should be printed or not
+   * \note The period before the projection is only simulated once, and each scenario is then simulated by a separate process on a copy of the model, with the model output for each scenario printed to separate files.  The model itself is simulated with the current values of the parameters for the whole period
+   */
+  void Project(StochasticData* const data, int year, int print);
   /**
    * \brief This function will calculate the predation, and update the population, on an area
    * \param area is the area to calculate the predation on (default value 0)
@@ -207,6 +236,66 @@ public:
    * \note This function gets updated values for the model parameters from the optimisation algorithm and performs a model run based on these new values, calculating a new likelihood score that is then returned to the optimisation algorithm
    */
   double SimulateAndUpdate(const DoubleVector& x);
+  /**
+   * \brief This function will update the model parameters, run the model and calculate a likelihood score for a batch of points
+   * \param x is the DoubleMatrix containing the updated values for the parameters, with one point on each row
+   * \param scores is the DoubleVector that will contain the likelihood score for each point
+   * \note The points will be evaluated concurrently on copies of the model if more than one core has been specified, and the model will not be left at any of the points
+   */
+  void SimulateAndUpdateBatch(const DoubleMatrix& x, DoubleVector& scores);
+  /**
+   * \brief This function will run the model and calculate the likelihood scores for each point in a batch of points
+   * \param x is the DoubleMatrix containing the values of all the parameters, with one point on each row
+   * \param scores is the DoubleMatrix that will contain the total likelihood score followed by the unweighted score from each likelihood component, with one point on each row
+   * \note The points are simulated one after another, with nothing shared between them, and these evaluations are not counted as function evaluations of an optimising run
+   */
+  void SimulatePoints(const DoubleMatrix& x, DoubleMatrix& scores);
+  /**
+   * \brief This function will calculate the Hessian matrix of the likelihood score at the current point, and write it to file
+   * \param filename is the name of the file to write the Hessian information to
+   * \param prec is the precision to use in the output file
+   */
+  void calcHessian(const char* const filename, int prec);
+  /**
+   * \brief This function will create the LikelihoodCache used to store the likelihood scores for the points that have been evaluated
+   * \param size is the maximum number of points that will be stored
+   * \param filename is the name of the file that the points will also be stored in (NULL if the points are not to be stored in a file)
+   */
+  void createCache(int size, const char* const filename);
+  /**
+   * \brief This function will create the Checkpoint used to save the state of the optimisation
+   * \param filename is the name of the file that the state of the optimisation will be saved to
+   * \param interval is the number of function evaluations between saving the state of the optimisation
+   * \param resumefile is the name of the file that the state of the optimisation will be restored from (NULL if the optimisation is to start from the beginning)
+   */
+  void createCheckpoint(const char* const filename, int interval, const char* const resumefile);
+  /**
+   * \brief This function will create the StatusBlock used to write information about the progress of the optimisation
+   * \param filename is the name of the status file
+   */
+  void createStatus(const char* const filename);
+  /**
+   * \brief This function will check whether the state of the optimisation should be saved
+   * \return 1 if the state should be saved, 0 otherwise
+   */
+  int checkpointDue() const { return ((checkpoint != 0) && (checkpoint->isDue(funceval))); };
+  /**
+   * \brief This function will check whether the current optimisation algorithm should restore its state
+   * \return 1 if the state should be restored, 0 otherwise
+   */
+  int isResuming() const { return ((checkpoint != 0) && (checkpoint->isResuming())); };
+  /**
+   * \brief This function will start to save the state of the optimisation
+   * \return the Checkpoint that the optimisation algorithm should then write its own state to
+   * \note The optimisation algorithm must call Checkpoint::closeWrite() once its state has been written
+   */
+  Checkpoint* writeCheckpoint();
+  /**
+   * \brief This function will return the Checkpoint that the optimisation algorithm should restore its state from
+   * \return checkpoint
+   * \note The optimisation algorithm must call Checkpoint::closeRead() once its state has been read
+   */
+  Checkpoint* getCheckpoint() { return checkpoint; };
   /**
    * \brief This function will return the likelihood score from the current simulation
    * \return likelihood score
@@ -217,6 +306,11 @@ public:
    * \return number of iterations
    */
   int getFuncEval() const { return funceval; };
+  /**
+   * \brief This function will return the number of processes used to evaluate batches of points
+   * \return numcores
+   */
+  int getNumCores() const { return numcores; };
   /**
    * \brief This function will return the current time in the simulation
    * \return current time
@@ -237,6 +331,11 @@ public:
    * \return number of timesteps
    */
   int numTotalSteps() const { return TimeInfo->numTotalSteps(); };
+  /**
+   * \brief This function will check whether any of the timesteps in the model are split into substeps
+   * \return 1 if there is a timestep with more than one substep, 0 otherwise
+   */
+  int hasSubSteps() const { return TimeInfo->hasSubSteps(); };
   /**
    * \brief This function will return the likelihood components used in the simulation
    * \return LikelihoodPtrVector containing all the likelihood components used in the simulation
@@ -262,6 +361,51 @@ public:
    */
   volatile int interrupted;
 protected:
+  /**
+   * \brief This function will reset the model at the start of a simulation
+   */
+  void startSimulation();
+  /**
+   * \brief This function will simulate the population in the model for the current timestep
+   * \param print is the flag to denote whether the model output should be printed or not
+   */
+  void simulateTimeStep(int print);
+  /**
+   * \brief This function will calculate the likelihood score at the end of a simulation
+   */
+  void finishSimulation();
+  /**
+   * \brief This function will wait for a process simulating a projection scenario to finish
+   */
+  void waitForScenario();
+  /**
+   * \brief This function will update the model parameters with new values from the optimisation algorithm
+   * \param x is the DoubleVector containing the updated values for the parameters
+   */
+  void updateOptValues(const DoubleVector& x);
+  /**
+   * \brief This function will write the current values of the parameters and the likelihood scores to the output file, if this is one of the function evaluations that should be printed
+   */
+  void printOptValues();
+  /**
+   * \brief This function will set the likelihood scores for the current values of the parameters to scores that have already been calculated
+   * \param scores is the DoubleVector containing the total likelihood score followed by the unweighted score from each likelihood component
+   * \note Any parameters that are outside the bounds are moved back to the bounds, as they would have been by simulating the model
+   */
+  void restoreScores(const DoubleVector& scores);
+  /**
+   * \brief This function will run the model for a number of points concurrently, with each point evaluated by a separate process on a copy of the model
+   * \param x is the DoubleMatrix containing the scaled values of the optimising parameters, with one point on each row
+   * \param points is the IntVector of the rows of x that will be evaluated
+   * \param scores is the DoubleMatrix that will contain the total likelihood score followed by the unweighted score from each likelihood component for each point that has been evaluated
+   * \param done is the IntVector that will be set to 1 for each point that has been evaluated
+   */
+  void simulateInChildren(const DoubleMatrix& x, const IntVector& points, DoubleMatrix& scores, IntVector& done);
+  /**
+   * \brief This function will restore the state of the optimisation that has been saved to file
+   * \return the index of the optimisation algorithm that was running when the state was saved
+   */
+  int readCheckpoint();
   /**
    * \brief This is the value of the likelihood score for the current simulation
    */
@@ -322,6 +466,39 @@ protected:
    * \brief This is the counter for the printing interval for the -o output from the simualtion
    */
   int printcount;
+  /**
+   * \brief This is the number of processes that can be used to evaluate a batch of points
+   */
+  int numcores;
+  /**
+   * \brief This is the LikelihoodCache used to store the likelihood scores for the points that have been evaluated (0 if no scores are to be stored)
+   */
+  LikelihoodCache* cache;
+  /**
+   * \brief This is the hash value calculated from the contents of the input files for the model
+   */
+  unsigned int modelhash;
+  /**
+   * \brief This is the DoubleVector used to store the likelihood scores for the current point
+   * \note This vector is only used to temporarily store values during an optimising run
+   */
+  DoubleVector cachescores;
+  /**
+   * \brief This is the flag used to denote whether the likelihood score for the last point was found in the LikelihoodCache (so the model has not been simulated for that point)
+   */
+  int cachehit;
+  /**
+   * \brief This is the Checkpoint used to save the state of the optimisation (0 if the state is not to be saved)
+   */
+  Checkpoint* checkpoint;
+  /**
+   * \brief This is the index of the optimisation algorithm that is currently running
+   */
+  int curopt;
+  /**
+   * \brief This is the StatusBlock used to write information about the progress of the optimisation (0 if no information is to be written)
+   */
+  StatusBlock* status;
   /**
    * \brief This is the DoubleVector used to store the initial values of the parameters
    * \note This vector is only used to temporarily store values during an optimising run
@@ -173,6 +173,17 @@ public:
    * \brief This function will return the flag denoting whether a NaN error has been rasied or not
    */
   void setNaNFlag(int flag) { nanflag = flag; };
+  /**
+   * \brief This function will set the flag denoting whether the contents of the files that are opened should be included in the hash value for the input files or not
+   * \param flag is the flag denoting whether the files should be included or not
+   * \note The hash value is reset when the flag is set
+   */
+  void setHashFiles(int flag);
+  /**
+   * \brief This function will return the hash value calculated from the contents of the input files
+   * \return filehash
+   */
+  unsigned int getFileHash() const { return filehash; };
 protected:
   /**
    * \brief This ofstream is the file that all the logging information will get sent to
@@ -183,6 +194,14 @@ protected:
    */
   StrStack* files;
 private:
+  /**
+   * \brief This is the flag used to denote whether the contents of the files that are opened are included in the hash value or not
+   */
+  int hashfiles;
+  /**
+   * \brief This is the hash value calculated from the contents of the input files
+   */
+  unsigned int filehash;
   /**
    * \brief This is the flag used to denote whether a NaN error has been raised or nont
    */
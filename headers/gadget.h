@@ -33,6 +33,14 @@ This document is the developers manual for Gadget, and describes the classes, fu
 #include <unistd.h>
 #ifdef NOT_WINDOWS
 #include <sys/utsname.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <cerrno>
 #endif
 #include <sys/param.h>
 
@@ -6,4 +6,13 @@
 extern RunID RUNID;
 extern ErrorHandler handle;
 
-#endif
\ No newline at end of file
+#ifdef DEBUG
+/**
+ * \brief This function will return the number of heap allocations that have been made
+ * \return number of allocations
+ * \note This is only available when Gadget has been compiled with the DEBUG flag, and is used to check that a model simulation does not allocate any memory
+ */
+long numAllocations();
+#endif
+
+#endif
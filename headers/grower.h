@@ -6,6 +6,7 @@
 #include "commentstream.h"
 #include "popinfomatrix.h"
 #include "doublematrixptrvector.h"
+#include "intvector.h"
 #include "livesonareas.h"
 #include "formulavector.h"
 #include "keeper.h"
@@ -110,6 +111,13 @@ public:
    */
   int getFixedWeights() { return fixedweights; };
 protected:
+  /**
+   * \brief This will calculate the beta binomial distribution of the increase in length of the stock
+   * \param inarea is the index for the area that the growth is being calculated on
+   * \param Lengths is the LengthGroupDivision of the stock
+   * \note The distribution is only calculated for the length groups where the mean growth has changed, and is copied from another area if the mean growth is the same on that area
+   */
+  void calcLengthDistribution(int inarea, const LengthGroupDivision* const Lengths);
   /**
    * \brief This is the PopInfoMatrix used to store information about the current population of the stock that is to grow according to the growth calculations
    */
@@ -157,6 +165,10 @@ protected:
    * \note The values of this vector are set to zero, and never used, unless the growth function depends on the feeding level of the stock (ie. growth is based on consumption of preys)
    */
   DoubleVector dummyfphi;
+  /**
+   * \brief This is the DoubleVector used to store the mean length of each length group raised to the power used in the growth calculation
+   */
+  DoubleVector lengthPower;
   /**
    * \brief This is the GrowthCalcBase used to calculate the growth information
    */
@@ -174,13 +186,18 @@ protected:
    */
   int maxlengthgroupgrowth;
   /**
-   * \brief This is the mean growth, as calculated for this length group by the GrowthCalc function
+   * \brief This is the DoubleMatrix used to store the mean growth that was used to calculate the beta binomial distribution for each length group
+   * \note The indices for this object are [area][stock length], and the value is negative if the distribution has not been calculated
+   */
+  DoubleMatrix lastGrowth;
+  /**
+   * \brief This is the IntVector used to store the length groups that the beta binomial distribution needs to be calculated for
    */
-  double growth;
+  IntVector calcIndex;
   /**
-   * \brief This is the value of alpha in the beta binomial distribution
+   * \brief This is the DoubleVector of the values of alpha in the beta binomial distribution for each length group that is being calculated
    */
-  double alpha;
+  DoubleVector alpha;
   /**
    * \brief This is the value of beta in the beta binomial distribution
    */
@@ -196,13 +213,13 @@ protected:
    */
   DoubleVector part2;
   /**
-   * \brief This is a double used when calculating the beta binomial distribution
+   * \brief This is a DoubleVector used when calculating the beta binomial distribution for each length group that is being calculated
    * \note This stores the value of gamma(alpha+beta)/gamma(n+alpha+beta)
    */
-  double part3;
+  DoubleVector part3;
   /**
-   * \brief This is a DoubleVector used when calculating the beta binomial distribution
-   * \note This stores the value of gamma(x+alpha)/gamma(x)
+   * \brief This is a DoubleVector used when calculating the beta binomial distribution for each length group that is being calculated
+   * \note This stores the value of gamma(x+alpha)/gamma(x) for the current value of x
    */
   DoubleVector part4;
 };
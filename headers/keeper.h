@@ -7,12 +7,14 @@
 #include "stochasticdata.h"
 #include "addresskeepermatrix.h"
 #include "strstack.h"
+#include "doublematrix.h"
+#include "checkpoint.h"
 
 /**
  * \class Keeper
  * \brief This is the class used to store information about the variables that are used in model simulation
  *
- * This class stores all the information about the variables that are used in the model simulation.  This includes the current value, the initial value and best value found so far by any optimisation routines, the upper and lower bounds for the variables and a flag to denote whether the variable is to be optimised or not.  This class also updates the model parameters with new values for the variables, either as a result of the optimisation routines or when new values for the parameters are received from the network if the simulation is part of a parallel optimisation, using paramin.
+ * This class stores all the information about the variables that are used in the model simulation.  This includes the current value, the initial value and best value found so far by any optimisation routines, the upper and lower bounds for the variables and a flag to denote whether the variable is to be optimised or not.  This class also updates the model parameters with new values for the variables, either as a result of the optimisation routines or when new values for the parameters are received from the network if the simulation is part of a parallel optimisation, using paramin.  The names of the switches and the addresses of the variables are stored in hash tables, so that the switch for a variable can be found quickly when the model is read in.
  */
 class Keeper {
 public:
@@ -113,6 +115,11 @@ public:
    * \param val is the DoubleVector that will contain a copy of the current values
    */
   void getCurrentValues(DoubleVector& val) const;
+  /**
+   * \brief This function will return a copy of the value of the variables at the best point found during the optimisation
+   * \param val is the DoubleVector that will contain a copy of the best values
+   */
+  void getBestValues(DoubleVector& val) const;
   /**
    * \brief This function will return a copy of the lower bounds of the variables to be optimised
    * \param lbs is the DoubleVector that will contain a copy of the lower bounds
@@ -183,10 +190,29 @@ public:
    * \param interrupt is the flag to denote whether the current run was interrupted by the user or not
    */
   void writeParams(const OptInfoPtrVector& optvec, const char* const filename, int prec, int interrupt);
+  /**
+   * \brief This function will write the Hessian matrix, the inverse Hessian matrix and the correlation matrix for the optimised parameters to file
+   * \param filename is the name of the file to write the model information to
+   * \param hess is the DoubleMatrix containing the Hessian matrix
+   * \param invhess is the DoubleMatrix containing the inverse Hessian matrix (empty if the Hessian matrix could not be inverted)
+   * \param likvalue is the likelihood value at the point where the Hessian matrix was calculated
+   * \param prec is the precision to use in the output file
+   */
+  void writeHessian(const char* const filename, const DoubleMatrix& hess, const DoubleMatrix& invhess, double likvalue, int prec);
   /**
    * \brief This function will display information about the best values of the parameters found so far during an optimisation run
    */
   void writeBestValues();
+  /**
+   * \brief This function will save the current and best values of the parameters found so far during an optimisation run
+   * \param check is the Checkpoint that the values will be written to
+   */
+  void writeCheckpoint(Checkpoint* const check) const;
+  /**
+   * \brief This function will restore the current and best values of the parameters found so far during an optimisation run
+   * \param check is the Checkpoint that the values will be read from
+   */
+  void readCheckpoint(Checkpoint* const check);
   /**
    * \brief This function will check that the values of the parameters are within the bounds specified in the input file
    * \param likevec is the LikelihoodPtrVector containing the likelihood components for the current model
@@ -202,11 +228,81 @@ public:
    * \return bestlikelihood
    */
   double getBestLikelihoodScore() const { return bestlikelihood; };
+  /**
+   * \brief This function will return the number of times that the values of the parameters have been updated
+   * \return numupdates
+   * \note This can be used to check whether any values that have been calculated from the parameters need to be calculated again
+   */
+  int numUpdates() const { return numupdates; };
 protected:
+  /**
+   * \brief This function will find a parameter in the list of switches
+   * \param attr is the Parameter to search for
+   * \return index of the switch, or -1 if the parameter has not been found
+   */
+  int findSwitch(const Parameter& attr) const;
+  /**
+   * \brief This function will find a variable in the index of the addresses of the variables
+   * \param var is the address of the variable to search for
+   * \return entry in the index of the addresses, or -1 if the variable has not been found
+   */
+  int findAddress(const double* var) const;
+  /**
+   * \brief This function will add a switch to the index of the names of the switches
+   * \param index is the index of the switch
+   */
+  void addSwitch(int index);
+  /**
+   * \brief This function will add a variable to the index of the addresses of the variables
+   * \param row is the index of the switch for the variable
+   * \param col is the position of the variable in the list of variables for that switch
+   */
+  void addAddress(int row, int col);
+  /**
+   * \brief This function will remove a variable from the index of the addresses of the variables
+   * \param entry is the entry in the index of the addresses for the variable
+   */
+  void removeAddress(int entry);
+  /**
+   * \brief This function will calculate the index of the names of the switches
+   */
+  void buildSwitchIndex();
+  /**
+   * \brief This function will calculate the index of the addresses of the variables
+   */
+  void buildAddressIndex();
   /**
    * \brief This is the AddressKeeperMatrix used to store information about the value and name of the parameters
    */
   AddressKeeperMatrix address;
+  /**
+   * \brief This is the IntVector of the first switch in each hash bucket for the names of the switches (-1 if the bucket is empty)
+   */
+  IntVector switchbuckets;
+  /**
+   * \brief This is the IntVector of the next switch in the same hash bucket (-1 if this is the last switch)
+   */
+  IntVector switchchain;
+  /**
+   * \brief This is the IntVector of the first entry in each hash bucket for the addresses of the variables (-1 if the bucket is empty)
+   */
+  IntVector addressbuckets;
+  /**
+   * \brief This is the IntVector of the next entry in the same hash bucket, or the next unused entry (-1 if this is the last entry)
+   */
+  IntVector addresschain;
+  /**
+   * \brief This is the IntVector of the index of the switch for each entry for the addresses of the variables
+   */
+  IntVector addressrow;
+  /**
+   * \brief This is the IntVector of the position of the variable in the list of variables for that switch for each entry
+   */
+  IntVector addresscol;
+  /**
+   * \brief This is the first unused entry for the addresses of the variables (-1 if there are no unused entries)
+   */
+  int freeaddress;
   /**
    * \brief This is the DoubleVector used to store the initial values of the parameters
    */
@@ -260,6 +356,10 @@ protected:
    * \brief This is the flag used to denote whether an output file has been specified or not
    */
   int fileopen;
+  /**
+   * \brief This is the number of times that the values of the parameters have been updated
+   */
+  int numupdates;
   /**
    * \brief This ofstream is the file that all the parameter information gets sent to
    */
@@ -36,6 +36,11 @@ public:
    * \return the mean length of the length group
    */
   double meanLength(int i) const;
+  /**
+   * \brief This function will return the mean lengths of all the length groups
+   * \return DoubleVector of the mean lengths
+   */
+  const DoubleVector& meanLengths() const { return meanlength; };
   /**
    * \brief This function will return the minimum length of a specified length group
    * \param i is the identifier of the length group
@@ -32,6 +32,7 @@ public:
     likelihood = 0.0;
     weight = w;
     type = T;
+    printlikelihood = 0;
   };
   /**
    * \brief This is the default Likelihood destructor
@@ -84,6 +85,12 @@ public:
    * \return likelihood
    */
   double getUnweightedLikelihood() const { return likelihood; };
+  /**
+   * \brief This will set the unweighted likelihood score for the likelihood component
+   * \param lik is the unweighted likelihood score
+   * \note This is used to restore a likelihood score that has been stored, instead of calculating it again
+   */
+  void setUnweightedLikelihood(double lik) { likelihood = lik; };
   /**
    * \brief This will return the weight applied to the likelihood component
    * \return weight
@@ -95,6 +102,11 @@ public:
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {};
+  /**
+   * \brief This will set the flag used to denote whether the likelihood information will be printed
+   * \note This must be set before the fleets and stocks are selected, so that the likelihood component can decide how much of the model data to store
+   */
+  void setPrintLikelihood() { printlikelihood = 1; };
 protected:
   /**
    * \brief This stores the calculated score for the likelihood component
@@ -104,6 +116,10 @@ protected:
    * \brief This stores the weight to be applied to the likelihood component
    */
   double weight;
+  /**
+   * \brief This is the flag used to denote whether the likelihood information will be printed (and so whether the model data needs to be stored for every timestep)
+   */
+  int printlikelihood;
 private:
   /**
    * \brief This denotes what type of likelihood class has been created
@@ -0,0 +1,122 @@
+#ifndef likelihoodcache_h
+#define likelihoodcache_h
+
+#include "doublematrix.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "parametervector.h"
+#include "likelihoodptrvector.h"
+#include "gadget.h"
+
+/**
+ * \class LikelihoodCache
+ * \brief This is the class used to store the likelihood scores for the points that have recently been evaluated during an optimising run
+ *
+ * This class stores the total likelihood score, and the unweighted likelihood score from each likelihood component, for a fixed number of the most recently evaluated points.  The points are stored using the unscaled values of all the model parameters, in a hash table, so that a point that is evaluated more than once (for example at the end of each optimisation algorithm) only needs to be simulated once.  Optionally, the entries can also be written to a binary file, so that a subsequent run of the same model can reuse the likelihood scores that have already been calculated.
+ */
+class LikelihoodCache {
+public:
+  /**
+   * \brief This is the LikelihoodCache constructor
+   * \param size is the maximum number of points that will be stored
+   * \param switches is the ParameterVector of the names of the model parameters
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the current model
+   * \param modelhash is the hash value calculated from the contents of the input files for the current model
+   */
+  LikelihoodCache(int size, const ParameterVector& switches, const LikelihoodPtrVector& likevec, unsigned int modelhash);
+  /**
+   * \brief This is the default LikelihoodCache destructor
+   */
+  ~LikelihoodCache();
+  /**
+   * \brief This function will search for a point in the cache
+   * \param point is the DoubleVector containing the values of all the model parameters
+   * \param scores is the DoubleVector that will contain the total likelihood score followed by the score from each likelihood component, if the point has been found
+   * \return 1 if the point has been found, 0 otherwise
+   */
+  int findPoint(const DoubleVector& point, DoubleVector& scores);
+  /**
+   * \brief This function will store a point in the cache, replacing the oldest entry if the cache is full
+   * \param point is the DoubleVector containing the values of all the model parameters
+   * \param scores is the DoubleVector containing the total likelihood score followed by the score from each likelihood component
+   */
+  void storePoint(const DoubleVector& point, const DoubleVector& scores);
+  /**
+   * \brief This function will read any previously stored points from file, and then open the file so that new points are added to the end of it
+   * \param filename is the name of the file that the points will be stored in
+   */
+  void openFile(const char* const filename);
+  /**
+   * \brief This function will return the number of times that a point has been found in the cache
+   * \return number of points found
+   */
+  int numHits() const { return hits; };
+  /**
+   * \brief This function will return the number of points currently stored in the cache
+   * \return number of points stored
+   */
+  int numStored() const { return numstored; };
+private:
+  /**
+   * \brief This function will calculate the hash value for a point
+   * \param point is the DoubleVector containing the values of all the model parameters
+   * \return hash value
+   */
+  unsigned int calcHash(const DoubleVector& point) const;
+  /**
+   * \brief This function will add a point to the cache, without writing it to file
+   * \param point is the DoubleVector containing the values of all the model parameters
+   * \param scores is the DoubleVector containing the total likelihood score followed by the score from each likelihood component
+   */
+  void addPoint(const DoubleVector& point, const DoubleVector& scores);
+  /**
+   * \brief This is the maximum number of points that can be stored
+   */
+  int maxsize;
+  /**
+   * \brief This is the number of points currently stored
+   */
+  int numstored;
+  /**
+   * \brief This is the position of the next entry to be used (which will be the oldest entry once the cache is full)
+   */
+  int nextpos;
+  /**
+   * \brief This is the number of times that a point has been found in the cache
+   */
+  int hits;
+  /**
+   * \brief This is the hash value calculated from the names of the switches and likelihood components, and the contents of the input files, used to check files that are read in
+   */
+  unsigned int signature;
+  /**
+   * \brief This is the DoubleMatrix of the points that are stored
+   */
+  DoubleMatrix points;
+  /**
+   * \brief This is the DoubleMatrix of the likelihood scores for the points that are stored
+   */
+  DoubleMatrix values;
+  /**
+   * \brief This is the IntVector of the hash values for the points that are stored
+   */
+  IntVector hashes;
+  /**
+   * \brief This is the IntVector of the first entry in each hash bucket (-1 if the bucket is empty)
+   */
+  IntVector buckets;
+  /**
+   * \brief This is the IntVector of the next entry in the same hash bucket (-1 if this is the last entry)
+   */
+  IntVector chain;
+  /**
+   * \brief This is the flag used to denote whether a file for the points has been opened or not
+   */
+  int fileopen;
+  /**
+   * \brief This is the ofstream that new points are written to
+   */
+  ofstream outfile;
+};
+
+#endif
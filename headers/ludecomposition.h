@@ -12,7 +12,7 @@ public:
   /**
    * \brief This is the default LUDecomposition constructor
    */
-  LUDecomposition() {};
+  LUDecomposition() { size = 0; };
   /**
    * \brief This is the LUDecomposition constructor for a given DoubleMatrix
    * \param A is the DoubleMatrix that will be decomposed into a lower triangular matrix L and an upper triangular matrix U
@@ -22,12 +22,25 @@ public:
    * \brief This is the default LUDecomposition destructor
    */
   ~LUDecomposition() {};
+  /**
+   * \brief This function will calculate the LU decomposition of a DoubleMatrix, replacing any previous decomposition
+   * \param A is the DoubleMatrix that will be decomposed into a lower triangular matrix L and an upper triangular matrix U
+   * \note This function does not allocate any memory if the DoubleMatrix is the same size as the previous one
+   */
+  void Decompose(const DoubleMatrix& A);
   /**
    * \brief This function will solve the matrix equation A = bx and return the resulting DoubleVector
    * \param b is the DoubleVector that is to be used to solve the matrix equation A = bx
    * \return x, the solution of the matrix equation A = bx
    */
   DoubleVector Solve(const DoubleVector& b);
+  /**
+   * \brief This function will solve the matrix equation A = bx, storing the result in a DoubleVector that has already been created
+   * \param b is the DoubleVector that is to be used to solve the matrix equation A = bx
+   * \param x is the DoubleVector that will contain the solution of the matrix equation A = bx
+   * \note This function does not allocate any memory, so it can be used when calculating the likelihood score
+   */
+  void Solve(const DoubleVector& b, DoubleVector& x);
   /**
    * \brief This function will return the log of the determinate of the matrix
    * \return logdet
@@ -47,6 +60,10 @@ private:
    * \brief This is the upper triangular DoubleMatrix
    */
   DoubleMatrix U;
+  /**
+   * \brief This is the DoubleVector used to temporarily store the solution of the lower triangular matrix equation
+   */
+  DoubleVector y;
   /**
    * \brief This is the log of the determinate of the matrix
    */
@@ -65,6 +65,36 @@ public:
    * \param filename is the name of the file
    */
   void setOptInfoFile(char* filename);
+  /**
+   * \brief This function will store the filename that the likelihood scores will be stored in
+   * \param filename is the name of the file
+   */
+  void setCacheFile(char* filename);
+  /**
+   * \brief This function will store the filename that the state of the optimisation will be saved to
+   * \param filename is the name of the file
+   */
+  void setCheckpointFile(char* filename);
+  /**
+   * \brief This function will store the filename that the state of the optimisation will be restored from
+   * \param filename is the name of the file
+   */
+  void setResumeFile(char* filename);
+  /**
+   * \brief This function will store the filename that the progress of the optimisation will be written to
+   * \param filename is the name of the file
+   */
+  void setStatusFile(char* filename);
+  /**
+   * \brief This function will store the name of the socket that the model will be evaluated through
+   * \param filename is the name of the socket
+   */
+  void setServerFile(char* filename);
+  /**
+   * \brief This function will store the filename that the values of the parameters for the projection scenarios will be read from
+   * \param filename is the name of the file
+   */
+  void setProjectionFile(char* filename);
   /**
    * \brief This function will return the flag used to determine whether the likelihood score should be optimised
    * \return flag
@@ -85,6 +115,76 @@ public:
    * \return flag
    */
   int runPrint() const { return runprint; };
+  /**
+   * \brief This function will return the flag used to determine whether the Hessian matrix should be calculated at the final point
+   * \return flag
+   */
+  int runHessian() const { return runhessian; };
+  /**
+   * \brief This function will return the flag used to determine whether the model without substeps should be optimised before the full model
+   * \return flag
+   */
+  int runNoSubSteps() const { return runnosubsteps; };
+  /**
+   * \brief This function will return the flag used to determine whether the model should be evaluated for other programs through a local socket
+   * \return flag
+   */
+  int runServer() const { return (strServerFile != NULL); };
+  /**
+   * \brief This function will return the flag used to determine whether projection scenarios should be simulated from the state of the model at the start of the projection
+   * \return flag
+   */
+  int runProjection() const { return (strProjectionFile != NULL); };
+  /**
+   * \brief This function will return the number of processes that can be used to evaluate a batch of points
+   * \return numcores
+   */
+  int getNumCores() const { return numcores; };
+  /**
+   * \brief This function will return the number of points that the likelihood scores will be stored for
+   * \return cachesize
+   */
+  int getCacheSize() const { return cachesize; };
+  /**
+   * \brief This function will return the filename that the likelihood scores will be stored in
+   * \return filename
+   */
+  char* getCacheFile() const { return strCacheFile; };
+  /**
+   * \brief This function will return the filename that the state of the optimisation will be saved to
+   * \return filename
+   */
+  char* getCheckpointFile() const { return strCheckpointFile; };
+  /**
+   * \brief This function will return the filename that the state of the optimisation will be restored from
+   * \return filename
+   */
+  char* getResumeFile() const { return strResumeFile; };
+  /**
+   * \brief This function will return the filename that the progress of the optimisation will be written to
+   * \return filename
+   */
+  char* getStatusFile() const { return strStatusFile; };
+  /**
+   * \brief This function will return the name of the socket that the model will be evaluated through
+   * \return filename
+   */
+  char* getServerFile() const { return strServerFile; };
+  /**
+   * \brief This function will return the filename that the values of the parameters for the projection scenarios will be read from
+   * \return filename
+   */
+  char* getProjectionFile() const { return strProjectionFile; };
+  /**
+   * \brief This function will return the first year of the projection
+   * \return projectionyear
+   */
+  int getProjectionYear() const { return projectionyear; };
+  /**
+   * \brief This function will return the number of function evaluations between saving the state of the optimisation
+   * \return checkpointiter
+   */
+  int getCheckpointIter() const { return checkpointiter; };
   /**
    * \brief This function will return the flag used to determine whether the optimisation parameters have been given
    * \return flag
@@ -171,6 +271,30 @@ private:
    * \brief This is the name of the file that the main model information will be read from
    */
   char* strMainGadgetFile;
+  /**
+   * \brief This is the name of the file that the likelihood scores will be stored in
+   */
+  char* strCacheFile;
+  /**
+   * \brief This is the name of the file that the state of the optimisation will be saved to
+   */
+  char* strCheckpointFile;
+  /**
+   * \brief This is the name of the file that the state of the optimisation will be restored from
+   */
+  char* strResumeFile;
+  /**
+   * \brief This is the name of the file that the progress of the optimisation will be written to
+   */
+  char* strStatusFile;
+  /**
+   * \brief This is the name of the socket that the model will be evaluated through
+   */
+  char* strServerFile;
+  /**
+   * \brief This is the name of the file that the values of the parameters for the projection scenarios will be read from
+   */
+  char* strProjectionFile;
   /**
    * \brief This is the PrintInfo used to store information about the format the model parameters should be written to file
    */
@@ -199,6 +323,14 @@ private:
    * \brief This is the flag used to denote whether the current simulation should print model output or not
    */
   int runprint;
+  /**
+   * \brief This is the flag used to denote whether the Hessian matrix should be calculated at the final point or not
+   */
+  int runhessian;
+  /**
+   * \brief This is the flag used to denote whether the model without substeps should be optimised before the full model or not
+   */
+  int runnosubsteps;
   /**
    * \brief This is the flag used to override the default settings and force the model to print model output at the end of an optimisation run
    */
@@ -215,6 +347,22 @@ private:
    * \brief This is the value used to decide on the level of warnings displayed during the model run
    */
   int printLogLevel;
+  /**
+   * \brief This is the number of processes that can be used to evaluate a batch of points
+   */
+  int numcores;
+  /**
+   * \brief This is the number of points that the likelihood scores will be stored for
+   */
+  int cachesize;
+  /**
+   * \brief This is the number of function evaluations between saving the state of the optimisation
+   */
+  int checkpointiter;
+  /**
+   * \brief This is the first year of the projection
+   */
+  int projectionyear;
   /**
    * \brief This is the maximum ratio of a stock that can be consumed on any given timestep
    */
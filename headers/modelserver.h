@@ -0,0 +1,103 @@
+#ifndef modelserver_h
+#define modelserver_h
+
+#include "intvector.h"
+#include "doublevector.h"
+#include "gadget.h"
+
+/**
+ * \class ModelServer
+ * \brief This is the class used to evaluate the model for values of the parameters that are sent by other programs through a local socket
+ *
+ * This class creates a Unix domain socket and then waits for other programs to connect to it and send requests, one request on each line of text.  The model is only read and initialised once, and a number of worker processes are then created, each with its own copy of the initialised model, so that each connection is served by one of the workers and several programs can evaluate the model at the same time.  A request to simulate the model contains the values of all the parameters, in the order that they are listed in the parameter file, and the reply contains the total likelihood score followed by the unweighted likelihood score from each likelihood component.  A request to simulate a batch of points contains the number of points followed by the values of the parameters for each point, with one line in the reply for each point.  This is only a convenience to avoid sending one request for each point, since the points are simulated one after another by the worker that serves the connection.  If a worker fails then it is replaced by a new worker with a copy of the initialised model.
+ *
+ * \note This class is only available on platforms that support Unix domain sockets
+ */
+class ModelServer {
+public:
+  /**
+   * \brief This is the ModelServer constructor
+   * \param filename is the name of the socket that other programs will connect to
+   * \param numproc is the number of worker processes that will evaluate the model
+   * \param print is the flag to denote whether the model output can be printed to file
+   */
+  ModelServer(const char* const filename, int numproc, int print);
+  /**
+   * \brief This is the default ModelServer destructor
+   */
+  ~ModelServer();
+  /**
+   * \brief This function will create the worker processes and then wait until the server is stopped by an interrupt
+   */
+  void Serve();
+private:
+  /**
+   * \brief This function will create a worker process
+   * \param id is the number of the worker process
+   */
+  void startWorker(int id);
+  /**
+   * \brief This function will accept connections and serve the requests sent through them until the worker process is stopped
+   */
+  void runWorker();
+  /**
+   * \brief This function will serve the requests sent through a connection until the connection is closed
+   * \param fd is the file descriptor of the connection
+   */
+  void serveConnection(int fd);
+  /**
+   * \brief This function will serve one request
+   * \param request is the line of text containing the request
+   * \param outfile is the stream that the reply will be written to
+   */
+  void serveRequest(char* request, FILE* outfile);
+  /**
+   * \brief This function will read the values of the parameters for one point from the request that is being served
+   * \param vec is the DoubleVector that will contain the values of the parameters
+   * \param outfile is the stream that any error message will be written to
+   * \return 1 if the values have been read, 0 otherwise
+   */
+  int readValues(DoubleVector& vec, FILE* outfile);
+  /**
+   * \brief This function will check that there is nothing left in the request that is being served
+   * \param outfile is the stream that any error message will be written to
+   * \return 1 if there is nothing left, 0 otherwise
+   */
+  int checkEnd(FILE* outfile);
+  /**
+   * \brief This function will write the likelihood scores for one point as the reply to a request
+   * \param scores is the DoubleVector containing the total likelihood score followed by the unweighted score from each likelihood component
+   * \param outfile is the stream that the reply will be written to
+   */
+  void writeScores(const DoubleVector& scores, FILE* outfile);
+  /**
+   * \brief This is the name of the socket that other programs will connect to
+   */
+  char* socketname;
+  /**
+   * \brief This is the file descriptor of the socket that other programs will connect to
+   */
+  int listenfd;
+  /**
+   * \brief This is the file used to make sure that only one worker prints the model output at a time
+   */
+  FILE* lockfile;
+  /**
+   * \brief This is the number of worker processes that will evaluate the model
+   */
+  int numproc;
+  /**
+   * \brief This is the flag to denote whether the model output can be printed to file
+   */
+  int print;
+  /**
+   * \brief This is the IntVector of the process ids of the worker processes
+   */
+  IntVector pids;
+  /**
+   * \brief This is the DoubleVector used to store the values of the parameters sent with a request
+   */
+  DoubleVector values;
+};
+
+#endif
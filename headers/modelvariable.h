@@ -63,6 +63,7 @@ public:
    * \brief This function will check to see if the ModelVariable value has changed
    * \param TimeInfo is the TimeClass for the current model
    * \return 1 if the values have changed, 0 otherwise
+   * \note On the first timestep this will only return 1 if the value has changed since the last timestep that the ModelVariable was updated on, which will be from the previous simulation, so that any values that were calculated from the ModelVariable can be reused
    */
   int didChange(const TimeClass* const TimeInfo);
   /**
@@ -91,6 +92,15 @@ private:
    * \brief This is the value of the ModelVariable
    */
   double value;
+  /**
+   * \brief This is the flag to denote whether the value has changed since the last timestep that the ModelVariable was updated on
+   */
+  int changed;
+  /**
+   * \brief This is the timestep that the ModelVariable was last updated on
+   * \note This is -1 if the ModelVariable hasn't been updated since the value was set
+   */
+  int updatetime;
 };
 
 #endif
@@ -47,6 +47,10 @@ protected:
    * \brief This is the log likelihood score
    */
   double loglikelihood;
+  /**
+   * \brief This is the DoubleVector used to store the log factorial of the data values
+   */
+  DoubleVector logdata;
 };
 
 #endif
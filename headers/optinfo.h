@@ -5,8 +5,9 @@
 #include "doublematrix.h"
 #include "doublevector.h"
 #include "intvector.h"
+#include "checkpoint.h"
 
-enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS };
+enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS, OPTLBFGS, OPTDE };
 
 /**
  * \class OptInfo
@@ -45,6 +46,16 @@ public:
    * \return type
    */
   OptType getType() const { return type; };
+  /**
+   * \brief This function will save the results from the optimisation algorithm
+   * \param check is the Checkpoint that the results will be written to
+   */
+  void writeCheckpoint(Checkpoint* const check) const { check->write(converge); check->write(iters); check->write(score); };
+  /**
+   * \brief This function will restore the results from the optimisation algorithm
+   * \param check is the Checkpoint that the results will be read from
+   */
+  void readCheckpoint(Checkpoint* const check) { check->read(converge); check->read(iters); check->read(score); };
 protected:
   /**
    * \brief This is the flag used to denote whether the optimisation converged or not
@@ -109,6 +120,31 @@ private:
    * \return the best function value found from the search
    */
   double bestNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
+  /**
+   * \brief This function will check whether a step should be taken when looking for the best point
+   * \param k is the index of the parameter that the step is taken for
+   * \param step is the length of the step
+   * \return 1 if the step should be taken, 0 otherwise
+   * \note Steps that the surrogate model does not expect to improve the point are still taken with probability given by verify
+   */
+  int takeStep(int k, double step);
+  /**
+   * \brief This function will update the surrogate model for a parameter from a single step
+   * \param k is the index of the parameter that the step was taken for
+   * \param step is the length of the step
+   * \param fbase is the function value before the step
+   * \param fstep is the function value after the step
+   */
+  void updateSurrogate(int k, double step, double fbase, double fstep);
+  /**
+   * \brief This function will update the surrogate model for a parameter from a step in both directions
+   * \param k is the index of the parameter that the steps were taken for
+   * \param step is the length of the step
+   * \param fbase is the function value before the steps
+   * \param fplus is the function value after the step of length step
+   * \param fminus is the function value after the step of length -step
+   */
+  void updateSurrogate(int k, double step, double fbase, double fplus, double fminus);
   /**
    * \brief This is the maximum number of iterations for the Hooke & Jeeves optimisation
    */
@@ -129,6 +165,27 @@ private:
    * \brief This is the limit when checking if a parameter is stuck on the bound
    */
   double bndcheck;
+  /**
+   * \brief This is the DoubleVector of the slope of the surrogate model for each parameter
+   */
+  DoubleVector slope;
+  /**
+   * \brief This is the DoubleVector of the curvature of the surrogate model for each parameter
+   */
+  DoubleVector curve;
+  /**
+   * \brief This is the IntVector of the flags to denote how much of the surrogate model has been estimated for each parameter
+   * \note This is 0 if nothing has been estimated, 1 if only the slope has been estimated and 2 if both the slope and the curvature have been estimated
+   */
+  IntVector fitted;
+  /**
+   * \brief This is the flag to denote whether the surrogate model should be used to screen the steps
+   */
+  int surrogate;
+  /**
+   * \brief This is the probability of taking a step that the surrogate model does not expect to improve the point
+   */
+  double verify;
 };
 
 /**
@@ -250,6 +307,13 @@ public:
    * \brief This is the function that will calculate the likelihood score using the BFGS optimiser
    */
   virtual void OptimiseLikelihood();
+  /**
+   * \brief This function will numerically calculate the Hessian matrix of the function at the current point
+   * \param point is the DoubleVector that contains the parameters corresponding to the current function value
+   * \param pointvalue is the current function value
+   * \param hess is the DoubleMatrix that will contain the Hessian matrix for the current point
+   */
+  void hessian(DoubleVector& point, double pointvalue, DoubleMatrix& hess);
 private:
   /**
    * \brief This function will numerically calculate the gradient of the function at the current point
@@ -263,7 +327,7 @@ private:
    * \param M is the DoubleMatrix containing the inverse Hessian matrix
    * \return the smallest eigen value of the matrix
    */
-  double getSmallestEigenValue(DoubleMatrix M);
+  double getSmallestEigenValue(const DoubleMatrix& M);
   /**
    * \brief This is the maximum number of function evaluations for the BFGS optimiation
    */
@@ -298,4 +362,144 @@ private:
   double gradeps;
 };
 
+/**
+ * \class OptInfoLBFGS
+ * \brief This is the class used for the limited memory BFGS optimisation
+ *
+ * L-BFGS is a quasi-Newton optimisation method that is based on the BFGS algorithm, but instead of storing a dense approximation to the inverse Hessian matrix it only stores the changes in the point and the gradient from the last few iterations.  The search direction is then calculated directly from these stored vectors using the ''two-loop recursion'', which means that both the memory and the time needed for each iteration increase linearly with the number of parameters, rather than quadratically as for the BFGS algorithm.  The search direction and the Armijo linesearch are projected onto the bounds of the scaled parameters, so any parameters that are at a bound are held fixed while the gradient points out of the feasible region.
+ *
+ * The L-BFGS algorithm used in Gadget is derived from that presented by Jorge Nocedal and Stephen J Wright, ''Numerical Optimization'' (2nd edition, pp176-180) published by Springer.
+ */
+class OptInfoLBFGS : public OptInfo  {
+public:
+  /**
+   * \brief This is the default OptInfoLBFGS constructor
+   */
+  OptInfoLBFGS();
+  /**
+   * \brief This is the default OptInfoLBFGS destructor
+   */
+  ~OptInfoLBFGS() {};
+  /**
+   * \brief This is the function used to read in the L-BFGS parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the L-BFGS optimiser
+   */
+  virtual void OptimiseLikelihood();
+private:
+  /**
+   * \brief This function will numerically calculate the gradient of the function at the current point
+   * \param point is the DoubleVector that contains the parameters corresponding to the current function value
+   * \param pointvalue is the current function value
+   * \param newgrad is the DoubleVector that will contain the gradient vector for the current point
+   * \param lower is the DoubleVector that contains the scaled lower bounds of the parameters
+   * \param upper is the DoubleVector that contains the scaled upper bounds of the parameters
+   * \note The difference is taken backwards for any parameter that would otherwise move above the upper bound, unless this would move further below the lower bound, and the step is limited so that it stays within the bounds
+   */
+  void gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad, const DoubleVector& lower, const DoubleVector& upper);
+  /**
+   * \brief This is the maximum number of function evaluations for the L-BFGS optimiation
+   */
+  int lbfgsiter;
+  /**
+   * \brief This is the halt criteria for the L-BFGS algorithm
+   */
+  double lbfgseps;
+  /**
+   * \brief This is the number of previous iterations that are stored to calculate the search direction
+   */
+  int memory;
+  /**
+   * \brief This is the adjustment factor in the Armijo linesearch
+   */
+  double beta;
+  /**
+   * \brief This is the halt criteria for the Armijo linesearch
+   */
+  double sigma;
+  /**
+   * \brief This is the initial step size for the Armijo linesearch
+   */
+  double step;
+  /**
+   * \brief This is the accuracy term used when calculating the gradient
+   */
+  double gradacc;
+  /**
+   * \brief This is the factor used to adjust the gradient accuracy term
+   */
+  double gradstep;
+  /**
+   * \brief This is the halt criteria for the gradient accuracy term
+   */
+  double gradeps;
+};
+
+/**
+ * \class OptInfoDE
+ * \brief This is the class used for the Differential Evolution optimisation
+ *
+ * Differential Evolution is a global optimisation method that works with a population of points spread through the search area, rather than a single point.  For each generation, a trial point is created for every member of the population by adding the scaled difference between two randomly chosen members to a third member, and then crossing this with the original member.  The trial point will replace the original member if it has a better likelihood score.  As the population converges on the optimum the differences between the members get smaller, so the size of the steps taken by the algorithm decline.  The trial points for each generation are independent of each other, and so they can be evaluated concurrently.
+ *
+ * The Differential Evolution algorithm used in Gadget is derived from that presented by Rainer Storn and Kenneth Price, ''Differential Evolution - A Simple and Efficient Heuristic for Global Optimization over Continuous Spaces'' in the December 1997 (Vol. 11, pp. 341-359) issue of the Journal of Global Optimization.
+ */
+class OptInfoDE : public OptInfo  {
+public:
+  /**
+   * \brief This is the default OptInfoDE constructor
+   */
+  OptInfoDE();
+  /**
+   * \brief This is the default OptInfoDE destructor
+   */
+  ~OptInfoDE() {};
+  /**
+   * \brief This is the function used to read in the Differential Evolution parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the Differential Evolution optimiser
+   */
+  virtual void OptimiseLikelihood();
+private:
+  /**
+   * \brief This is the maximum number of function evaluations for the Differential Evolution optimiation
+   */
+  int deiter;
+  /**
+   * \brief This is the halt criteria for the Differential Evolution algorithm
+   */
+  double deeps;
+  /**
+   * \brief This is the number of members in the population
+   */
+  int popsize;
+  /**
+   * \brief This is the factor used to scale the difference between the members of the population
+   */
+  double weight;
+  /**
+   * \brief This is the probability that each parameter of the trial point is taken from the difference
+   */
+  double crossover;
+};
+
 #endif
@@ -1,6 +1,7 @@
 #ifndef popinfo_h
 #define popinfo_h
 
+#include "mathfunc.h"
 #include "gadget.h"
 
 /**
@@ -49,6 +50,22 @@ public:
    * \param a is the PopInfo to add
    */
   PopInfo& operator += (const PopInfo& a);
+  /**
+   * \brief This function will add an existing PopInfo to the current PopInfo, which is being used to sum a population
+   * \param a is the PopInfo to add
+   * \note While the population is being summed W stores the total biomass rather than the mean weight, which avoids calculating a new mean weight every time a PopInfo is added.  The mean weight is calculated when finaliseSum() is called
+   */
+  void addToSum(const PopInfo& a) { N += a.N; W += a.N * a.W; };
+  /**
+   * \brief This function will calculate the mean weight of the PopInfo once the population has been summed
+   */
+  void finaliseSum() {
+    if (isZero(N)) {
+      N = 0.0;
+      W = 0.0;
+    } else
+      W /= N;
+  };
   /**
    * \brief This operator will multiply the PopInfo by a constant
    * \param a is the constant
@@ -73,20 +73,26 @@ public:
    */
   int Size() const { return size; };
   /**
-   * \brief This function will add a PopInfoIndexVector to the current vector
+   * \brief This function will add a PopInfoIndexVector to the current vector, which is being used to sum a population
    * \param Addition is the PopInfoIndexVector that will be added to the current vector
    * \param CI is the ConversionIndex that will convert between the length groups of the 2 vectors
    * \param ratio is a multiplicative constant applied to each entry (default value 1.0)
+   * \note The current vector stores the total biomass instead of the mean weight until finaliseSum() is called
    */
   void Add(const PopInfoIndexVector& Addition, const ConversionIndex& CI, double ratio = 1.0);
   /**
-   * \brief This function will add a PopInfoIndexVector to the current vector
+   * \brief This function will add a PopInfoIndexVector to the current vector, which is being used to sum a population
    * \param Addition is the PopInfoIndexVector that will be added to the current vector
    * \param CI is the ConversionIndex that will convert between the length groups of the 2 vectors
    * \param Ratio is a DoubleVector of multiplicative constants to be applied to entries individually
    * \param ratio is a multiplicative constant applied to each entry (default value 1.0)
+   * \note The current vector stores the total biomass instead of the mean weight until finaliseSum() is called
    */
   void Add(const PopInfoIndexVector& Addition, const ConversionIndex& CI, const DoubleVector& Ratio, double ratio = 1.0);
+  /**
+   * \brief This function will calculate the mean weight of each entry once the population has been summed
+   */
+  void finaliseSum();
 protected:
   /**
    * \brief This is the index for the vector
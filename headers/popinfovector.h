@@ -69,6 +69,11 @@ public:
    * \param CI is the ConversionIndex to be used to convert from one length grouping to another
    */
   void Sum(const PopInfoVector* const Number, const ConversionIndex& CI);
+  /**
+   * \brief This function will calculate the mean weight of each element once the population has been summed
+   * \note While the population is being summed the elements store the total biomass instead of the mean weight
+   */
+  void finaliseSum();
 protected:
   /**
    * \brief This is the vector of PopInfo values
@@ -12,7 +12,7 @@ public:
   /**
    * \brief This is the default PopRatioVector constructor
    */
-  PopRatioVector() { size = 0; v = 0;};
+  PopRatioVector() { size = 0; capacity = 0; v = 0;};
   /**
    * \brief This is the PopRatioVector constructor for a specified size with an initial value
    * \param sz is the size of the vector to be created
@@ -43,7 +43,7 @@ public:
   /**
    * \brief This will delete an entry from the vector
    * \param pos is the element of the vector to be deleted
-   * \note This will free the memory allocated to the deleted element of the vector
+   * \note The memory allocated to the vector is kept so that it can be reused when new entries are added
    */
   void Delete(int pos);
   /**
@@ -72,6 +72,10 @@ protected:
    * \brief This is the size of the vector
    */
   int size;
+  /**
+   * \brief This is the number of entries that the memory allocated to the vector can hold
+   */
+  int capacity;
 };
 
 #endif
@@ -75,6 +75,21 @@ public:
    * \return name
    */
   const char* getFileName() const { return filename; };
+  /**
+   * \brief This will make sure that all the information printed so far has been written to the output file
+   */
+  void flushFile() { outfile.flush(); };
+  /**
+   * \brief This will copy the information printed so far to a new output file for a projection scenario
+   * \param id is the number of the projection scenario, which is added to the name of the output file
+   */
+  void copyFile(int id) const;
+  /**
+   * \brief This will print the rest of the requested information to the output file for a projection scenario
+   * \param id is the number of the projection scenario, which is added to the name of the output file
+   * \note The output file for the projection scenario must already have been created using copyFile()
+   */
+  void branchFile(int id);
   /**
    * \brief This will return the type of printer class
    * \return type
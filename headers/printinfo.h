@@ -42,6 +42,11 @@ public:
    * \param prec is the precision
    */
   void setPrecision(int prec) { givenPrecision = prec; };
+  /**
+   * \brief This function will set the flag used to denote whether the model parameters should be printed to file
+   * \param print is the flag
+   */
+  void setPrint(int print) { printoutput = print; };
   /**
    * \brief This function will check the printing intervals and precision values that have been set, and override them with default vakues if required
    * \param net is the flag to denote whether the current model run is a network run or not
@@ -97,6 +97,12 @@ protected:
    */
   void readNumberData(CommentStream& infile, Keeper* const keeper,
      const TimeClass* const TimeInfo, const AreaClass* const Area, int minage, int maxage);
+  /**
+   * \brief This is the function used to calculate the renewal population for a renewal entry
+   * \param i is the index of the renewal entry
+   * \note The renewal population is only calculated again if the parameters used to calculate it have changed
+   */
+  void updateDistribution(int i);
   /**
    * \brief This is the identifier of the function to be used to read the renewal data from file
    */
@@ -121,6 +127,15 @@ protected:
    * \brief This is the AgeBandMatrixPtrVector that contains the number and weight of the renewal population
    */
   AgeBandMatrixPtrVector renewalDistribution;
+  /**
+   * \brief This is the IntVector of flags to denote whether the renewal population has been calculated for each renewal entry
+   */
+  IntVector calculated;
+  /**
+   * \brief This is the DoubleMatrix of the parameters that were used to calculate the renewal population for each renewal entry
+   * \note This stores the mean length, standard deviation, condition factor (or multiplier) and power (if used)
+   */
+  DoubleMatrix calcValues;
   /**
    * \brief This is the FormulaMatrixPtrVector that contains the number (from the input file) of the renewal population
    */
@@ -153,6 +168,10 @@ protected:
    * \brief This is the DoubleVector of the reference weight values
    */
   DoubleVector refWeight;
+  /**
+   * \brief This is the DoubleVector used to store the length distribution while the renewal population is being calculated
+   */
+  DoubleVector lengthDist;
   /**
    * \brief This is the ConversionIndex used to convert from the renewal LengthGroupDivision to the stock LengthGroupDivision
    */
@@ -0,0 +1,132 @@
+#ifndef statusblock_h
+#define statusblock_h
+
+#include "doublevector.h"
+#include "likelihoodptrvector.h"
+#include "gadget.h"
+
+/**
+ * \brief This is the length of the text string used to describe what the model is currently doing
+ */
+const int StatusPhaseLength = 32;
+
+/**
+ * \struct StatusHeader
+ * \brief This is the structure stored at the start of the status file, which is followed by the likelihood scores and then the names of the likelihood components
+ */
+struct StatusHeader {
+  /**
+   * \brief This is the version of the layout of the status file
+   */
+  int version;
+  /**
+   * \brief This is the number of likelihood components
+   */
+  int numlike;
+  /**
+   * \brief This is the process id of the Gadget run that writes to the status file
+   */
+  int pid;
+  /**
+   * \brief This is the counter used to check that the status file is not read while it is being written (odd while it is being written)
+   */
+  volatile unsigned int sequence;
+  /**
+   * \brief This is the number of function evaluations that have been done
+   */
+  int funceval;
+  /**
+   * \brief This is the time that the status file was created
+   */
+  double starttime;
+  /**
+   * \brief This is the time that the status file was last updated
+   */
+  double updatetime;
+  /**
+   * \brief This is the recent number of function evaluations per second
+   */
+  double evalrate;
+  /**
+   * \brief This is the likelihood score for the last point that was evaluated
+   */
+  double likelihood;
+  /**
+   * \brief This is the best likelihood score that has been evaluated
+   */
+  double bestlikelihood;
+  /**
+   * \brief This is the text string used to describe what the model is currently doing
+   */
+  char phase[StatusPhaseLength];
+};
+
+/**
+ * \class StatusBlock
+ * \brief This is the class used to write information about the progress of an optimising run to a memory-mapped status file
+ *
+ * This class creates a file containing the number of function evaluations, the number of function evaluations per second, the current and best likelihood scores, the scores from each likelihood component and the optimisation algorithm that is running.  The file is mapped into memory and updated after every function evaluation, without writing any text, so that other programs can check the progress of a Gadget run with very little cost to the run.  A sequence counter is used so that the information can be read consistently without any locking.  The information can be displayed using the -watch switch.
+ *
+ * \note This class is only available on platforms that support memory-mapped files
+ */
+class StatusBlock {
+public:
+  /**
+   * \brief This is the StatusBlock constructor
+   * \param filename is the name of the status file
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the current model
+   */
+  StatusBlock(const char* const filename, const LikelihoodPtrVector& likevec);
+  /**
+   * \brief This is the default StatusBlock destructor
+   */
+  ~StatusBlock();
+  /**
+   * \brief This function will update the status file after a function evaluation
+   * \param funceval is the number of function evaluations that have been done
+   * \param scores is the DoubleVector containing the total likelihood score followed by the score from each likelihood component
+   */
+  void Update(int funceval, const DoubleVector& scores);
+  /**
+   * \brief This function will update the text string used to describe what the model is currently doing
+   * \param phase is the text string
+   */
+  void setPhase(const char* const phase);
+  /**
+   * \brief This function will display the information from a status file until the Gadget run that writes to it has finished
+   * \param filename is the name of the status file
+   */
+  static void Watch(const char* const filename);
+private:
+  /**
+   * \brief This function will return the current time
+   * \return time in seconds
+   */
+  static double getTime();
+  /**
+   * \brief This is the memory that the status file has been mapped to
+   */
+  char* block;
+  /**
+   * \brief This is the size of the status file
+   */
+  int blocksize;
+  /**
+   * \brief This is the StatusHeader at the start of the status file
+   */
+  StatusHeader* header;
+  /**
+   * \brief This is the array of the likelihood scores in the status file
+   */
+  double* scores;
+  /**
+   * \brief This is the time that the number of function evaluations per second was last calculated
+   */
+  double lasttime;
+  /**
+   * \brief This is the number of function evaluations when the number of function evaluations per second was last calculated
+   */
+  int lasteval;
+};
+
+#endif
@@ -454,6 +454,10 @@ protected:
    * \brief This is the PopInfoVector used to temporarily store the population during the migration calculation
    */
   PopInfoVector tmpMigrate;
+  /**
+   * \brief This is the DoubleVector used to temporarily store the proportion of the population that survives natural mortality on each substep
+   */
+  DoubleVector tmpMortality;
 };
 
 #endif
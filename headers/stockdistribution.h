@@ -179,6 +179,10 @@ private:
    * \brief This is the index of the timesteps for the likelihood component data
    */
   int timeindex;
+  /**
+   * \brief This is the index of the timesteps for the model data, which is only stored for each timestep if the likelihood information is printed
+   */
+  int modelindex;
   /**
    * \brief This ActionAtTimes stores information about when the likelihood score should be calculated
    */
@@ -5,6 +5,7 @@
 #include "lengthgroup.h"
 #include "commentstream.h"
 #include "agebandmatrixptrvector.h"
+#include "intmatrix.h"
 #include "poppredator.h"
 
 /**
@@ -118,6 +119,25 @@ protected:
    * \note The indices for this object are [area][predator length]
    */
   DoubleMatrix maxcons;
+  /**
+   * \brief This is the DoubleVector used to store the mean length of the predator raised to the power used when calculating the maximum consumption
+   * \note The indices for this object are [predator length]
+   */
+  DoubleVector lengthPower;
+  /**
+   * \brief This is the power that was used to calculate lengthPower
+   */
+  double lastPower;
+  /**
+   * \brief This is the IntMatrix used to store the first prey length group with a non-zero suitability
+   * \note The indices for this object are [prey][predator length]
+   */
+  IntMatrix minSuitLength;
+  /**
+   * \brief This is the IntMatrix used to store the prey length group after the last one with a non-zero suitability
+   * \note The indices for this object are [prey][predator length]
+   */
+  IntMatrix maxSuitLength;
   /**
    * \brief This is the AgeBandMatrixPtrVector used to store information about the predator population
    * \note The indices for this object are [area][predator age][predator length]
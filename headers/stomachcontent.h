@@ -56,6 +56,10 @@ public:
    * \param Preys is the PreyPtrVector of all the available preys
    */
   virtual void setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys);
+  /**
+   * \brief This will set the flag used to denote whether the likelihood information will be printed
+   */
+  void setPrintLikelihood() { printlikelihood = 1; };
   /**
    * \brief This function will print summary information from each StomachContent likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -159,6 +163,14 @@ protected:
    * \brief This is the index of the timesteps for the likelihood component data
    */
   int timeindex;
+  /**
+   * \brief This is the index of the timesteps for the model data, which is only stored for each timestep if the likelihood information is printed
+   */
+  int modelindex;
+  /**
+   * \brief This is the flag used to denote whether the likelihood information will be printed
+   */
+  int printlikelihood;
   /**
    * \brief This ActionAtTimes stores information about when the likelihood score should be calculated
    */
@@ -416,8 +428,10 @@ public:
    * \param Predators is the PredatorPtrVector of all the available predators
    * \param Preys is the PreyPtrVector of all the available preys
    */
-  void setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys)
-    { StomCont->setPredatorsAndPreys(Predators, Preys); };
+  void setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys) {
+    if (printlikelihood)
+      StomCont->setPrintLikelihood();
+    StomCont->setPredatorsAndPreys(Predators, Preys); };
   /**
    * \brief This function will print summary information from each StomachContent likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -185,6 +185,10 @@ private:
    * \brief This is the index of the timesteps for the likelihood component data
    */
   int timeindex;
+  /**
+   * \brief This is the index of the timesteps for the model data, which is only stored for each timestep if the likelihood information is printed
+   */
+  int modelindex;
   /**
    * \brief This is the value of epsilon used when calculating the likelihood score
    */
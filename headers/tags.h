@@ -46,6 +46,7 @@ public:
   void addToTagStock(int timeid);
 private:
   void readNumbers(CommentStream& infile, const char* tagname, const TimeClass* const TimeInfo);
+  void setStorage();
   CharPtrVector stocknames;
   //area-age-length distribution of tags by stocks
   AgeBandMatrixPtrMatrix AgeLengthStock;
@@ -14,7 +14,7 @@ public:
   /**
    * \brief This is the default TimeVariable constructor
    */
-  TimeVariable() { value = 0.0; lastvalue = -1.0; };
+  TimeVariable() { value = 0.0; lastvalue = -1.0; time = 0; changed = 0; keeper = 0; numupdates = -1; };
   /**
    * \brief This is the default TimeVariable destructor
    */
@@ -55,13 +55,18 @@ public:
   int didChange(const TimeClass* const TimeInfo);
 private:
   /**
-   * \brief This is the identifier for the last timestep that the value of the TimeVariable changed
+   * \brief This function will calculate the value of the TimeVariable for each timestep of the simulation
+   * \param TimeInfo is the TimeClass for the current model
    */
-  int timeid;
+  void setTimeValues(const TimeClass* const TimeInfo);
   /**
-   * \brief This is the last timestep that the value of the TimeVariable changed
+   * \brief This is the last timestep that the value of the TimeVariable was updated on
    */
   int time;
+  /**
+   * \brief This is the flag to denote whether the value of the TimeVariable changed on the last timestep that it was updated on
+   */
+  int changed;
   /**
    * \brief This is the IntVector of the years when the value of the TimeVariable changes
    */
@@ -74,6 +79,22 @@ private:
    * \brief This is the FormulaVector of the values of the TimeVariable
    */
   FormulaVector values;
+  /**
+   * \brief This is the DoubleVector of the value of the TimeVariable on each timestep of the simulation
+   */
+  DoubleVector timevalues;
+  /**
+   * \brief This is the IntVector of the flags to denote whether the value of the TimeVariable changes on each timestep of the simulation
+   */
+  IntVector timechanged;
+  /**
+   * \brief This is the Keeper for the current model, used to check whether the values of the parameters have been updated
+   */
+  const Keeper* keeper;
+  /**
+   * \brief This is the number of updates of the values of the parameters when the values for each timestep were calculated
+   */
+  int numupdates;
   /**
    * \brief This is the last value of the TimeVariable
    */
@@ -0,0 +1,54 @@
+#ifndef vectormath_h
+#define vectormath_h
+
+/**
+ * \brief This function will set the flag used to denote whether the fast versions of the vector mathematical functions should be used
+ * \param flag is the flag, 1 to use the fast versions and 0 to use the standard library versions
+ * \note The default is to use the standard library versions, so that the results of the model are not changed unless the -fastmath switch is given
+ */
+void setFastMath(int flag);
+
+/**
+ * \brief This function will return the flag used to denote whether the fast versions of the vector mathematical functions are used
+ * \return flag
+ */
+int getFastMath();
+
+/**
+ * \brief This function will calculate the exponential of each element of an array
+ * \param y is the array that the results will be stored in
+ * \param x is the array of values that the exponential will be calculated for
+ * \param n is the number of elements in the arrays
+ * \note The arrays y and x can be the same.  The fast version has a relative error of less than 2 ulp for arguments in the range -708 to 709, and uses the standard library version outside this range
+ */
+void vexp(double* y, const double* x, int n);
+
+/**
+ * \brief This function will calculate the natural logarithm of each element of an array
+ * \param y is the array that the results will be stored in
+ * \param x is the array of values that the logarithm will be calculated for
+ * \param n is the number of elements in the arrays
+ * \note The arrays y and x can be the same.  The fast version has an absolute error of less than 2 ulp of the result for positive normal arguments, and uses the standard library version for all other arguments
+ */
+void vlog(double* y, const double* x, int n);
+
+/**
+ * \brief This function will calculate the value of each element of an array raised to a given power
+ * \param y is the array that the results will be stored in
+ * \param x is the array of values that will be raised to the power
+ * \param p is the power
+ * \param n is the number of elements in the arrays
+ * \note The arrays y and x can be the same.  The fast version calculates exp(p * log(x)) and has a relative error of less than 2 * (1 + |p * log(x)|) ulp for positive normal arguments, and uses the standard library version for all other arguments
+ */
+void vpow(double* y, const double* x, double p, int n);
+
+/**
+ * \brief This function will calculate the logarithm of the gamma function for each element of an array
+ * \param y is the array that the results will be stored in
+ * \param x is the array of values that the log gamma function will be calculated for
+ * \param n is the number of elements in the arrays
+ * \note The arrays y and x can be the same.  The fast version has an absolute error of less than 2e-14 for positive arguments less than 10, and a relative error of less than 8 ulp for larger arguments, and uses the standard library version for all other arguments
+ */
+void vlgamma(double* y, const double* x, int n);
+
+#endif
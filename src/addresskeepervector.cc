@@ -12,30 +12,29 @@ void AddressKeeperVector::resize() {
   int i;
   if (v == 0) {
     v = new AddressKeeper[1];
-  } else {
-    AddressKeeper* vnew = new AddressKeeper[size + 1];
+    capacity = 1;
+  } else if (size == capacity) {
+    AddressKeeper* vnew = new AddressKeeper[2 * capacity];
     for (i = 0; i < size; i++)
       vnew[i] = v[i];
     delete[] v;
     v = vnew;
+    capacity = 2 * capacity;
   }
+  v[size] = (double*)0;
   size++;
 }
 
 void AddressKeeperVector::Delete(int pos) {
   int i;
   if (size > 1) {
-    AddressKeeper* vnew = new AddressKeeper[size - 1];
-    for (i = 0; i < pos; i++)
-      vnew[i] = v[i];
     for (i = pos; i < size - 1; i++)
-      vnew[i] = v[i + 1];
-    delete[] v;
-    v = vnew;
+      v[i] = v[i + 1];
     size--;
   } else {
     delete[] v;
     v = 0;
     size = 0;
+    capacity = 0;
   }
 }
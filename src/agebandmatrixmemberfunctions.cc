@@ -13,49 +13,19 @@ void AgeBandMatrix::Add(const AgeBandMatrix& Addition, const ConversionIndex &CI
   PopInfo pop;
   int minaddage = max(this->minAge(), Addition.minAge());
   int maxaddage = min(this->maxAge(), Addition.maxAge());
-  int age, l, minl, maxl;
+  int age, i, first, last;
 
   if ((maxaddage < minaddage) || (isZero(ratio)))
     return;
 
-  if (CI.isSameDl()) {
-    int offset = CI.getOffset();
-    for (age = minaddage; age <= maxaddage; age++) {
-      minl = max(this->minLength(age), Addition.minLength(age) + offset);
-      maxl = min(this->maxLength(age), Addition.maxLength(age) + offset);
-      for (l = minl; l < maxl; l++) {
-        pop = Addition[age][l - offset];
-        pop *= ratio;
-        (*v[age - minage])[l] += pop;
-      }
-    }
-
-  } else {
-    if (CI.isFiner()) {
-      for (age = minaddage; age <= maxaddage; age++) {
-        minl = max(this->minLength(age), CI.minPos(Addition.minLength(age)));
-        maxl = min(this->maxLength(age), CI.maxPos(Addition.maxLength(age) - 1) + 1);
-        for (l = minl; l < maxl; l++) {
-          pop = Addition[age][CI.getPos(l)];
-          pop *= ratio;
-          pop.N /= CI.getNumPos(l);  //JMB CI.getNumPos() should never be zero
-          (*v[age - minage])[l] += pop;
-        }
-      }
-
-    } else {
-      for (age = minaddage; age <= maxaddage; age++) {
-        minl = max(CI.minPos(this->minLength(age)), Addition.minLength(age));
-        maxl = min(CI.maxPos(this->maxLength(age) - 1) + 1, Addition.maxLength(age));
-        if (maxl > minl && CI.getPos(maxl - 1) < this->maxLength(age)
-            && CI.getPos(minl) >= this->minLength(age)) {
-          for (l = minl; l < maxl; l++) {
-            pop = Addition[age][l];
-            pop *= ratio;
-            (*v[age - minage])[CI.getPos(l)] += pop;
-          }
-        }
-      }
+  //JMB the conversion map has already been calculated so no branches are needed here
+  for (age = minaddage; age <= maxaddage; age++) {
+    CI.getRange(this->minLength(age), this->maxLength(age),
+      Addition.minLength(age), Addition.maxLength(age), first, last);
+    for (i = first; i < last; i++) {
+      pop = Addition[age][CI.getFrom(i)];
+      pop *= (ratio * CI.getWeight(i));
+      (*v[age - minage])[CI.getTo(i)] += pop;
     }
   }
 }
@@ -93,7 +63,8 @@ void AgeBandMatrix::sumColumns(PopInfoVector& Result) const {
     Result[i].setToZero();
   for (i = 0; i < nrow; i++)
     for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      Result[j] += (*v[i])[j];
+      Result[j].addToSum((*v[i])[j]);
+  Result.finaliseSum();
 }
 
 void AgeBandMatrix::IncrementAge() {
@@ -124,6 +95,12 @@ void AgeBandMatrix::setToZero() {
       (*v[i])[j].setToZero();
 }
 
+void AgeBandMatrix::finaliseSum() {
+  int i;
+  for (i = 0; i < nrow; i++)
+    (*v[i]).finaliseSum();
+}
+
 void AgeBandMatrix::printNumbers(ofstream& outfile) const {
   int i, j;
   int maxcol = 0;
@@ -172,10 +149,12 @@ void AgeBandMatrixPtrVector::Migrate(const DoubleMatrix& MI, PopInfoVector& tmp)
       //let tmp[j] keep the population of agelength group on area j after the migration
       for (j = 0; j < size; j++)
         for (i = 0; i < size; i++)
-          tmp[j] += (*v[i])[age][length] * MI[j][i];
+          tmp[j].addToSum((*v[i])[age][length] * MI[j][i]);
 
-      for (j = 0; j < size; j++)
+      for (j = 0; j < size; j++) {
+        tmp[j].finaliseSum();
         (*v[j])[age][length] = tmp[j];
+      }
     }
   }
 }
@@ -21,6 +21,8 @@ AgeBandMatrixRatioPtrVector::~AgeBandMatrixRatioPtrVector() {
   int i;
   for (i = 0; i < tagID.Size(); i++)
     delete[] tagID[i];
+  for (i = 0; i < storeID.Size(); i++)
+    delete[] storeID[i];
 
   if (v != 0) {
     for (i = 0; i < size; i++)
@@ -78,24 +80,44 @@ void AgeBandMatrixRatioPtrVector::resize(int addsize, int minage,
   }
 }
 
-// New memory has been allocated for each v[i][age][length][tag].N.
-// All v[i][age][length][tag].N, v[i][age][length][tag].R added equal -1.0.
+// v[i][age][length][tag].N points into the row of tagStore kept for tagname,
+// which is created the first time the tag is added and reused after that.
+// All v[i][age][length][tag].N, v[i][age][length][tag].R added equal 0.0.
 void AgeBandMatrixRatioPtrVector::addTag(const char* tagname) {
 
-  double* num;
-  int minlength, maxlength, age, length, i;
+  int minlength, maxlength, age, length, i, id, cell;
 
   this->addTagName(tagname);
   int minage = v[0]->minAge();
   int maxage = v[0]->maxAge();
+
+  id = -1;
+  for (i = 0; i < storeID.Size(); i++)
+    if (strcasecmp(storeID[i], tagname) == 0)
+      id = i;
+
+  if (id == -1) {
+    cell = 0;
+    for (i = 0; i < size; i++)
+      for (age = minage; age <= maxage; age++)
+        cell += v[i]->maxLength(age) - v[i]->minLength(age);
+
+    char* tempid = new char[strlen(tagname) + 1];
+    strcpy(tempid, tagname);
+    storeID.resize(tempid);
+    tagStore.AddRows(1, cell, 0.0);
+    id = storeID.Size() - 1;
+  } else
+    tagStore[id].setToZero();
+
+  cell = 0;
   for (i = 0; i < size; i++) {
     for (age = minage; age <= maxage; age++) {
       minlength = v[i]->minLength(age);
       maxlength = v[i]->maxLength(age);
       for (length = minlength; length < maxlength; length++) {
-        num = new double[1];
-        num[0] = 0.0;
-        (*v[i])[age][length].resize(num, 0.0);
+        (*v[i])[age][length].resize(&tagStore[id][cell], 0.0);
+        cell++;
       }
     }
   }
@@ -13,7 +13,7 @@
 extern Ecosystem* EcoSystem;
 
 /* calculate the smallest eigenvalue of a matrix */
-double OptInfoBFGS::getSmallestEigenValue(DoubleMatrix M) {
+double OptInfoBFGS::getSmallestEigenValue(const DoubleMatrix& M) {
 
   double eigen, temp, phi, norm;
   int i, j, k;
@@ -84,23 +84,106 @@ double OptInfoBFGS::getSmallestEigenValue(DoubleMatrix M) {
 /* by J E Dennis and Robert B Schnabel, published by SIAM, 1996             */
 void OptInfoBFGS::gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad) {
 
-  double ftmp, tmpacc;
-  int i, j;
+  int i;
   int nvars = point.Size();
-  DoubleVector gtmp(point);
+  DoubleVector tmpacc(nvars, 0.0);
+  DoubleVector ftmp(nvars, 0.0);
+  DoubleMatrix gtmp(nvars, nvars, 0.0);
 
   for (i = 0; i < nvars; i++) {
-    for (j = 0; j < nvars; j++)
-      gtmp[j] = point[j];
+    gtmp[i] = point;
 
     //JMB the scaled parameter values should aways be positive
     if (point[i] < 0.0)
       handle.logMessage(LOGINFO, "Error in BFGS - negative parameter when calculating the gradient", point[i]);
 
-    tmpacc = gradacc * max(point[i], 1.0);
-    gtmp[i] += tmpacc;
-    ftmp = EcoSystem->SimulateAndUpdate(gtmp);
-    newgrad[i] = (ftmp - pointvalue) / tmpacc;
+    tmpacc[i] = gradacc * max(point[i], 1.0);
+    gtmp[i][i] += tmpacc[i];
+  }
+
+  //JMB the points are independent so they can be evaluated concurrently
+  EcoSystem->SimulateAndUpdateBatch(gtmp, ftmp);
+  for (i = 0; i < nvars; i++)
+    newgrad[i] = (ftmp[i] - pointvalue) / tmpacc[i];
+}
+
+/* calculate the Hessian matrix of a function at a given point              */
+/* based on the finite difference Hessian approximation (A5.6.2 FDHESSF)    */
+/* Numerical Methods for Unconstrained Optimization and Nonlinear Equations */
+/* by J E Dennis and Robert B Schnabel, published by SIAM, 1996             */
+void OptInfoBFGS::hessian(DoubleVector& point, double pointvalue, DoubleMatrix& hess) {
+
+  double tmp;
+  int i, j;
+  int nvars = point.Size();
+  DoubleVector init(nvars, 0.0);
+  DoubleVector lower(nvars, 0.0);
+  DoubleVector upper(nvars, 0.0);
+  DoubleVector tmpacc(nvars, 0.0);
+  DoubleVector fneighbour(nvars, 0.0);
+  DoubleMatrix htmp(nvars, nvars, 0.0);
+
+  EcoSystem->getOptInitialValues(init);
+  EcoSystem->getOptLowerBounds(lower);
+  EcoSystem->getOptUpperBounds(upper);
+
+  for (i = 0; i < nvars; i++) {
+    // Scaling the bounds, because the parameters are scaled
+    lower[i] = lower[i] / init[i];
+    upper[i] = upper[i] / init[i];
+    if (lower[i] > upper[i]) {
+      tmp = lower[i];
+      lower[i] = upper[i];
+      upper[i] = tmp;
+    }
+  }
+
+  //JMB gradacc is the square root of the relative accuracy of the function
+  //but the step length for the Hessian should be the cube root of that accuracy
+  tmp = pow(gradacc, 2.0 / 3.0);
+  for (i = 0; i < nvars; i++) {
+    htmp[i] = point;
+
+    //JMB the scaled parameter values should aways be positive
+    if (point[i] < 0.0)
+      handle.logMessage(LOGINFO, "Error in BFGS - negative parameter when calculating the Hessian", point[i]);
+
+    //JMB step backwards if the stencil would go above the upper bound,
+    //unless there is even less room between the point and the lower bound
+    tmpacc[i] = tmp * max(point[i], 1.0);
+    if ((point[i] + 2.0 * tmpacc[i] > upper[i]) && (upper[i] - point[i] < point[i] - lower[i]))
+      tmpacc[i] = -tmpacc[i];
+
+    //JMB and then limit the step so that the stencil fits on that side
+    if (point[i] + 2.0 * tmpacc[i] > upper[i])
+      tmpacc[i] = 0.5 * (upper[i] - point[i]);
+    else if (point[i] + 2.0 * tmpacc[i] < lower[i])
+      tmpacc[i] = 0.5 * (lower[i] - point[i]);
+    htmp[i][i] += tmpacc[i];
+  }
+
+  EcoSystem->SimulateAndUpdateBatch(htmp, fneighbour);
+
+  //JMB the points f(x + h_i e_i) are reused for every element of the Hessian
+  //so each row then needs one more function evaluation for each element
+  for (i = 0; i < nvars; i++) {
+    DoubleVector ftmp(nvars - i, 0.0);
+    DoubleMatrix gtmp(nvars - i, nvars, 0.0);
+    for (j = i; j < nvars; j++) {
+      gtmp[j - i] = point;
+      gtmp[j - i][i] += tmpacc[i];
+      gtmp[j - i][j] += tmpacc[j];
+    }
+
+    EcoSystem->SimulateAndUpdateBatch(gtmp, ftmp);
+    for (j = i; j < nvars; j++) {
+      //JMB there is no room to move a parameter that is fixed by its bounds
+      if ((isZero(tmpacc[i])) || (isZero(tmpacc[j])))
+        hess[i][j] = 0.0;
+      else
+        hess[i][j] = ((pointvalue - fneighbour[i]) + (ftmp[j - i] - fneighbour[j])) / (tmpacc[i] * tmpacc[j]);
+      hess[j][i] = hess[i][j];
+    }
   }
 }
 
@@ -108,10 +191,11 @@ void OptInfoBFGS::OptimiseLikelihood() {
 
   double hy, yBy, temphy, tempyby, normgrad;
   double searchgrad, newf, tmpf, betan;
-  int i, j, resetgrad, offset, armijo;
+  int i, j, k, num, resetgrad, offset, armijo;
 
   handle.logMessage(LOGINFO, "\nStarting BFGS optimisation algorithm\n");
   int nvars = EcoSystem->numOptVariables();
+  int numcores = EcoSystem->getNumCores();
   DoubleVector x(nvars);
   DoubleVector trialx(nvars);
   DoubleVector bestx(nvars);
@@ -124,34 +208,68 @@ void OptInfoBFGS::OptimiseLikelihood() {
   DoubleVector search(nvars, 0.0);
   DoubleMatrix invhess(nvars, nvars, 0.0);
 
-  EcoSystem->scaleVariables();  //JMB need to scale variables
-  EcoSystem->getOptScaledValues(x);
-  EcoSystem->getOptInitialValues(init);
+  if (EcoSystem->isResuming()) {
+    //JMB continue the optimisation from the state that has been saved
+    Checkpoint* check = EcoSystem->getCheckpoint();
+    check->read(x);
+    check->read(bestx);
+    check->read(init);
+    check->read(grad);
+    check->read(oldgrad);
+    check->read(invhess);
+    check->read(newf);
+    check->read(resetgrad);
+    check->read(offset);
+    check->read(sigma);
+    check->read(gradacc);
+    check->closeRead(EcoSystem->getFuncEval());
+
+  } else {
+    EcoSystem->scaleVariables();  //JMB need to scale variables
+    EcoSystem->getOptScaledValues(x);
+    EcoSystem->getOptInitialValues(init);
 
-  for (i = 0; i < nvars; i++) {
-    trialx[i] = x[i];
-    bestx[i] = x[i];
-  }
+    for (i = 0; i < nvars; i++) {
+      trialx[i] = x[i];
+      bestx[i] = x[i];
+    }
 
-  newf = EcoSystem->SimulateAndUpdate(trialx);
-  if (newf != newf) { // check for NaN
-    handle.logMessage(LOGINFO, "Error starting BFGS optimisation with f(x) = infinity");
-    converge = -1;
-    iters = 1;
-    return;
-  }
+    newf = EcoSystem->SimulateAndUpdate(trialx);
+    if (newf != newf) { // check for NaN
+      handle.logMessage(LOGINFO, "Error starting BFGS optimisation with f(x) = infinity");
+      converge = -1;
+      iters = 1;
+      return;
+    }
 
-  this->gradient(trialx, newf, grad);
-  tmpf = newf;
-  offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
-  sigma = -sigma; //JMB change sign of sigma (and consequently searchgrad)
-  resetgrad = 0;
-  for (i = 0; i < nvars; i++) {
-    oldgrad[i] = grad[i];
-    invhess[i][i] = 1.0;
+    this->gradient(trialx, newf, grad);
+    tmpf = newf;
+    offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+    sigma = -sigma; //JMB change sign of sigma (and consequently searchgrad)
+    resetgrad = 0;
+    for (i = 0; i < nvars; i++) {
+      oldgrad[i] = grad[i];
+      invhess[i][i] = 1.0;
+    }
   }
 
   while (1) {
+    if (EcoSystem->checkpointDue()) {
+      Checkpoint* check = EcoSystem->writeCheckpoint();
+      check->write(x);
+      check->write(bestx);
+      check->write(init);
+      check->write(grad);
+      check->write(oldgrad);
+      check->write(invhess);
+      check->write(newf);
+      check->write(resetgrad);
+      check->write(offset);
+      check->write(sigma);
+      check->write(gradacc);
+      check->closeWrite();
+    }
+
     iters = EcoSystem->getFuncEval() - offset;
     if (isZero(newf)) {
       handle.logMessage(LOGINFO, "Error in BFGS optimisation after", iters, "function evaluations, f(x) = 0");
@@ -211,7 +329,38 @@ void OptInfoBFGS::OptimiseLikelihood() {
 
     armijo = 0;
     betan = step;
-    if (searchgrad > verysmall) {
+    if ((searchgrad > verysmall) && (numcores > 1)) {
+      //JMB evaluate a ladder of step lengths concurrently, and then take
+      //the largest step length that satisfies the armijo condition
+      while ((armijo == 0) && (betan > rathersmall)) {
+        num = 0;
+        tmpf = betan;
+        while ((num < numcores) && (tmpf > rathersmall)) {
+          num++;
+          tmpf *= beta;
+        }
+
+        DoubleVector ladderf(num, 0.0);
+        DoubleMatrix ladder(num, nvars, 0.0);
+        tmpf = betan;
+        for (k = 0; k < num; k++) {
+          for (i = 0; i < nvars; i++)
+            ladder[k][i] = x[i] + (tmpf * search[i]);
+          tmpf *= beta;
+        }
+
+        EcoSystem->SimulateAndUpdateBatch(ladder, ladderf);
+        for (k = 0; ((k < num) && (armijo == 0)); k++) {
+          if ((newf > ladderf[k]) && ((newf - ladderf[k]) > (betan * searchgrad))) {
+            armijo = 1;
+            tmpf = ladderf[k];
+            trialx = ladder[k];
+          } else
+            betan *= beta;
+        }
+      }
+
+    } else if (searchgrad > verysmall) {
       while ((armijo == 0) && (betan > rathersmall)) {
         for (i = 0; i < nvars; i++)
           trialx[i] = x[i] + (betan * search[i]);
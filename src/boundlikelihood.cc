@@ -177,6 +177,21 @@ void BoundLikelihood::addLikelihoodKeeper(const TimeClass* const TimeInfo, Keepe
     handle.logMessage(LOGMESSAGE, "Calculated likelihood score for boundlikelihood component to be", likelihood);
 }
 
+void BoundLikelihood::resetValues(Keeper* const keeper) {
+  int i;
+  //JMB the bounds are only set up when the component is first reset
+  if (!checkInitialised)
+    this->Reset(keeper);
+
+  keeper->getCurrentValues(values);
+  for (i = 0; i < switchnr.Size(); i++) {
+    if (values[switchnr[i]] < lowerbound[i])
+      keeper->Update(switchnr[i], lowerbound[i]);
+    else if (values[switchnr[i]] > upperbound[i])
+      keeper->Update(switchnr[i], upperbound[i]);
+  }
+}
+
 void BoundLikelihood::printSummary(ofstream& outfile) {
   //JMB there is only one likelihood score here ...
   if (!(isZero(likelihood))) {
@@ -30,6 +30,7 @@ CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* con
   CommentStream subdata(datafile);
 
   timeindex = 0;
+  modelindex = 0;
   yearly = 0;
   functionname = new char[MaxStrLength];
   strncpy(functionname, "", MaxStrLength);
@@ -212,8 +213,24 @@ CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* con
       }
       break;
     case 1:
+      //JMB create the vectors used when calculating the likelihood score here to avoid allocating memory later
+      datavec.resize(numage, 0.0);
+      modelvec.resize(numage, 0.0);
+      if (yearly)
+        handle.logMessage(LOGWARN, "Warning in catchdistribution - yearly aggregation is ignored for function", functionname);
+      yearly = 0;
+      break;
     case 5:
+      correlation.AddRows(numlen, numlen, 0.0);
+      datavec.resize(numlen, 0.0);
+      modelvec.resize(numlen, 0.0);
+      if (yearly)
+        handle.logMessage(LOGWARN, "Warning in catchdistribution - yearly aggregation is ignored for function", functionname);
+      yearly = 0;
+      break;
     case 6:
+      datavec.resize(numlen, 0.0);
+      modelvec.resize(numlen, 0.0);
       if (yearly)
         handle.logMessage(LOGWARN, "Warning in catchdistribution - yearly aggregation is ignored for function", functionname);
       yearly = 0;
@@ -290,12 +307,9 @@ void CatchDistribution::readDistributionData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-        }
       }
 
     } else
@@ -330,10 +344,11 @@ CatchDistribution::~CatchDistribution() {
   for (i = 0; i < lenindex.Size(); i++)
     delete[] lenindex[i];
   for (i = 0; i < obsDistribution.Nrow(); i++)
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
+  for (i = 0; i < modelDistribution.Nrow(); i++)
+    for (j = 0; j < modelDistribution.Ncol(i); j++)
       delete modelDistribution[i][j];
-    }
   for (i = 0; i < modelYearData.Size(); i++) {
     delete modelYearData[i];
     delete obsYearData[i];
@@ -454,7 +469,7 @@ void CatchDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
 }
 
 void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
-  int i, j, k, found, minage, maxage;
+  int i, j, k, found, minage, maxage, numtime;
   FleetPtrVector fleets;
   StockPtrVector stocks;
 
@@ -555,6 +570,17 @@ void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
   }
 
   aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+
+  //JMB only store the model data for every timestep if it is going to be printed,
+  //otherwise the same matrices are used for each timestep to save memory
+  numtime = obsDistribution.Nrow();
+  if ((!printlikelihood) && (numtime > 1))
+    numtime = 1;
+  for (i = 0; i < numtime; i++) {
+    modelDistribution.resize();
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
+      modelDistribution[i].resize(new DoubleMatrix(obsDistribution[i][j]->Nrow(), obsDistribution[i][j]->Ncol(), 0.0));
+  }
 }
 
 void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
@@ -573,6 +599,15 @@ void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchdistribution - invalid timestep");
 
+  //JMB the model data is only stored for this timestep if it is going to be printed
+  if (printlikelihood)
+    modelindex = timeindex;
+  else {
+    modelindex = 0;
+    for (i = 0; i < modelDistribution.Ncol(0); i++)
+      (*modelDistribution[0][i]).setToZero();
+  }
+
   aggregator->Sum();
   if ((handle.getLogLevel() >= LOGWARN) && (aggregator->checkCatchData()))
     handle.logMessage(LOGWARN, "Warning in catchdistribution - zero catch found");
@@ -620,8 +655,6 @@ double CatchDistribution::calcLikMultinomial() {
   int area, age, len;
   int numage = ages.Nrow();
   int numlen = LgrpDiv->numLengthGroups();
-  DoubleVector dist(numage, 0.0);
-  DoubleVector data(numage, 0.0);
 
   MN.Reset();
   //the object MN does most of the work, accumulating likelihood
@@ -629,22 +662,22 @@ double CatchDistribution::calcLikMultinomial() {
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[modelindex][area])[age][len] = ((*alptr)[area][age][len]).N;
 
     if (numage == 1) {
       //only one age-group, so calculate multinomial based on length distribution
       likelihoodValues[timeindex][area] +=
         MN.calcLogLikelihood((*obsDistribution[timeindex][area])[0],
-          (*modelDistribution[timeindex][area])[0]);
+          (*modelDistribution[modelindex][area])[0]);
 
     } else {
       //many age-groups, so calculate multinomial based on age distribution per length group
       for (len = 0; len < numlen; len++) {
         for (age = 0; age < numage; age++) {
-          dist[age] = (*modelDistribution[timeindex][area])[age][len];
-          data[age] = (*obsDistribution[timeindex][area])[age][len];
+          modelvec[age] = (*modelDistribution[modelindex][area])[age][len];
+          datavec[age] = (*obsDistribution[timeindex][area])[age][len];
         }
-        likelihoodValues[timeindex][area] += MN.calcLogLikelihood(data, dist);
+        likelihoodValues[timeindex][area] += MN.calcLogLikelihood(datavec, modelvec);
       }
     }
   }
@@ -669,17 +702,17 @@ double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[modelindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           likelihoodValues[timeindex][area] +=
-            ((*modelDistribution[timeindex][area])[age][len] -
+            ((*modelDistribution[modelindex][area])[age][len] -
             (*obsDistribution[timeindex][area])[age][len]) *
-            ((*modelDistribution[timeindex][area])[age][len] -
+            ((*modelDistribution[modelindex][area])[age][len] -
             (*obsDistribution[timeindex][area])[age][len]) /
-            fabs(((*modelDistribution[timeindex][area])[age][len] + epsilon));
+            fabs(((*modelDistribution[modelindex][area])[age][len] + epsilon));
         }
       }
       totallikelihood += likelihoodValues[timeindex][area];
@@ -693,7 +726,7 @@ double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[modelindex][area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -730,15 +763,15 @@ double CatchDistribution::calcLikGamma(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[modelindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           likelihoodValues[timeindex][area] +=
             (*obsDistribution[timeindex][area])[age][len] /
-            ((*modelDistribution[timeindex][area])[age][len] + epsilon) +
-            log((*modelDistribution[timeindex][area])[age][len] + epsilon);
+            ((*modelDistribution[modelindex][area])[age][len] + epsilon) +
+            log((*modelDistribution[modelindex][area])[age][len] + epsilon);
         }
       }
       totallikelihood += likelihoodValues[timeindex][area];
@@ -752,7 +785,7 @@ double CatchDistribution::calcLikGamma(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[modelindex][area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -790,12 +823,12 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[modelindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[modelindex][area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -811,7 +844,7 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[modelindex][area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -845,14 +878,14 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[modelindex][area])[age][len] = ((*alptr)[area][age][len]).N;
 
     totalmodel = 0.0;
     totaldata = 0.0;
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[modelindex][area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -865,7 +898,7 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
+            - ((*modelDistribution[modelindex][area])[age][len] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -880,7 +913,7 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[modelindex][area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -927,7 +960,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[modelindex][area])[age][len] = ((*alptr)[area][age][len]).N;
 
     if (!yearly) { //calculate likelihood on all steps
       //calculate an age distribution for each length class
@@ -935,7 +968,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
         totalmodel = 0.0;
         totaldata = 0.0;
         for (age = 0; age < numage; age++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[modelindex][area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
 
@@ -946,7 +979,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
         for (age = 0; age < numage; age++) {
           temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
+            - ((*modelDistribution[modelindex][area])[age][len] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -961,7 +994,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[modelindex][area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -999,7 +1032,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 void CatchDistribution::calcCorrelation() {
   int i, j, l, p;
   p = LgrpDiv->numLengthGroups();
-  DoubleMatrix correlation(p, p, 0.0);
+  correlation.setToZero();
 
   for (i = 0; i < lag; i++)
     if (fabs(params[i] - 1.0) > 1.0)
@@ -1017,7 +1050,7 @@ void CatchDistribution::calcCorrelation() {
       }
       correlation[i][i] += sigma * sigma;
     }
-    LU = LUDecomposition(correlation);
+    LU.Decompose(correlation);
   }
 }
 
@@ -1031,16 +1064,15 @@ double CatchDistribution::calcLikMVNormal() {
   if ((illegal) || (LU.isIllegal()) || isZero(sigma))
     return verybig;
 
-  DoubleVector diff(LgrpDiv->numLengthGroups(), 0.0);
   for (area = 0; area < areas.Nrow(); area++) {
     sumdata = 0.0;
     sumdist = 0.0;
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[modelindex][area])[age][len] = ((*alptr)[area][age][len]).N;
         sumdata += (*obsDistribution[timeindex][area])[age][len];
-        sumdist += (*modelDistribution[timeindex][area])[age][len];
+        sumdist += (*modelDistribution[modelindex][area])[age][len];
       }
     }
 
@@ -1054,12 +1086,13 @@ double CatchDistribution::calcLikMVNormal() {
       sumdist = 1.0 / sumdist;
 
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-      diff.setToZero();
+      datavec.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        diff[len] = ((*obsDistribution[timeindex][area])[age][len] * sumdata)
-                    - ((*modelDistribution[timeindex][area])[age][len] * sumdist);
+        datavec[len] = ((*obsDistribution[timeindex][area])[age][len] * sumdata)
+                    - ((*modelDistribution[modelindex][area])[age][len] * sumdist);
 
-      likelihoodValues[timeindex][area] += diff * LU.Solve(diff);
+      LU.Solve(datavec, modelvec);
+      likelihoodValues[timeindex][area] += datavec * modelvec;
     }
     totallikelihood += likelihoodValues[timeindex][area];
   }
@@ -1075,7 +1108,6 @@ double CatchDistribution::calcLikMVLogistic() {
   int age, len, area, p;
 
   p = LgrpDiv->numLengthGroups();
-  DoubleVector nu(p, 0.0);
 
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
@@ -1083,9 +1115,9 @@ double CatchDistribution::calcLikMVLogistic() {
       sumdata = 0.0;
       sumdist = 0.0;
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[modelindex][area])[age][len] = ((*alptr)[area][age][len]).N;
         sumdata += (*obsDistribution[timeindex][area])[age][len];
-        sumdist += (*modelDistribution[timeindex][area])[age][len];
+        sumdist += (*modelDistribution[modelindex][area])[age][len];
       }
 
       if (isZero(sumdata))
@@ -1098,17 +1130,17 @@ double CatchDistribution::calcLikMVLogistic() {
         sumdist = 1.0 / sumdist;
 
       sumnu = 0.0;
-      nu.setToZero();
+      datavec.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        nu[len] = log(((*obsDistribution[timeindex][area])[age][len] * sumdata) + verysmall)
-                  - log(((*modelDistribution[timeindex][area])[age][len] * sumdist) + verysmall);
+        datavec[len] = log(((*obsDistribution[timeindex][area])[age][len] * sumdata) + verysmall)
+                  - log(((*modelDistribution[modelindex][area])[age][len] * sumdist) + verysmall);
 
-        sumnu += nu[len];
+        sumnu += datavec[len];
       }
       sumnu = sumnu / p;
 
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        likelihoodValues[timeindex][area] += (nu[len] - sumnu) * (nu[len] - sumnu);
+        likelihoodValues[timeindex][area] += (datavec[len] - sumnu) * (datavec[len] - sumnu);
     }
     totallikelihood += likelihoodValues[timeindex][area];
   }
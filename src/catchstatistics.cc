@@ -28,6 +28,7 @@ CatchStatistics::CatchStatistics(CommentStream& infile, const AreaClass* const A
   CommentStream subdata(datafile);
 
   timeindex = 0;
+  modelindex = 0;
   functionname = new char[MaxStrLength];
   strncpy(functionname, "", MaxStrLength);
   readWordAndValue(infile, "datafile", datafilename);
@@ -160,22 +161,19 @@ void CatchStatistics::readStatisticsData(CommentStream& infile,
   strncpy(tmparea, "", MaxStrLength);
   strncpy(tmpage, "", MaxStrLength);
   strncpy(tmplen, "", MaxStrLength);
-  int keepdata, needvar, readvar;
+  int keepdata, readvar;
   int timeid, ageid, lenid, areaid, count, reject;
   
   //NK - add cases 6 and 7 (weight at length)
   readvar = 0;
-  needvar = 0;
   switch (functionnumber) {
   case 1:
     readvar = 0;
-    needvar = 1;
     break;
   case 2:
   case 3:
   case 6:
     readvar = 1;
-    needvar = 1;
     break;
   case 4:
   case 5:
@@ -241,11 +239,8 @@ void CatchStatistics::readStatisticsData(CommentStream& infile,
 	  likelihoodValues.AddRows(1, numarea, 0.0);
 	  numbers.resize(new DoubleMatrix(numarea, numlen, 0.0));
 	  obsMean.resize(new DoubleMatrix(numarea, numlen, 0.0));
-	  modelMean.resize(new DoubleMatrix(numarea, numlen, 0.0));
 	  if (readvar)
 	    obsStdDev.resize(new DoubleMatrix(numarea, numlen, 0.0));
-	  if (needvar)
-	    modelStdDev.resize(new DoubleMatrix(numarea, numlen, 0.0));
 	  
 	  timeid = (Years.Size() - 1);
 	}
@@ -306,11 +301,8 @@ void CatchStatistics::readStatisticsData(CommentStream& infile,
 	  likelihoodValues.AddRows(1, numarea, 0.0);
 	  numbers.resize(new DoubleMatrix(numarea, numage, 0.0));
 	  obsMean.resize(new DoubleMatrix(numarea, numage, 0.0));
-	  modelMean.resize(new DoubleMatrix(numarea, numage, 0.0));
 	  if (readvar)
 	    obsStdDev.resize(new DoubleMatrix(numarea, numage, 0.0));
-	  if (needvar)
-	    modelStdDev.resize(new DoubleMatrix(numarea, numage, 0.0));
 	  timeid = (Years.Size() - 1);
 	}
 
@@ -353,8 +345,9 @@ CatchStatistics::~CatchStatistics() {
   for (i = 0; i < numbers.Size(); i++) {
     delete numbers[i];
     delete obsMean[i];
-    delete modelMean[i];
   }
+  for (i = 0; i < modelMean.Size(); i++)
+    delete modelMean[i];
   for (i = 0; i < obsStdDev.Size(); i++)
     delete obsStdDev[i];
   for (i = 0; i < modelStdDev.Size(); i++)
@@ -391,7 +384,7 @@ void CatchStatistics::Print(ofstream& outfile) const {
 }
 
 void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
-  int i, j, k, found, minage, maxage;
+  int i, j, k, found, minage, maxage, numtime;
   FleetPtrVector fleets;
   StockPtrVector stocks;
 
@@ -501,6 +494,17 @@ void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector&
   }
 
   aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+
+  //JMB only store the model data for every timestep if it is going to be printed,
+  //otherwise the same matrices are used for each timestep to save memory
+  numtime = obsMean.Size();
+  if ((!printlikelihood) && (numtime > 1))
+    numtime = 1;
+  for (i = 0; i < numtime; i++) {
+    modelMean.resize(new DoubleMatrix(obsMean[i]->Nrow(), obsMean[i]->Ncol(), 0.0));
+    if (functionnumber == 1)
+      modelStdDev.resize(new DoubleMatrix(obsMean[i]->Nrow(), obsMean[i]->Ncol(), 0.0));
+  }
 }
 
 
@@ -517,6 +521,13 @@ void CatchStatistics::addLikelihood(const TimeClass* const TimeInfo) {
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchstatistics - invalid timestep");
 
+  //JMB the model data is only stored for this timestep if it is going to be printed
+  if (printlikelihood)
+    modelindex = timeindex;
+  else {
+    modelindex = 0;
+    (*modelMean[0]).setToZero();
+  }
 
   double l = 0.0;
   if (handle.getLogLevel() >= LOGMESSAGE)
@@ -548,12 +559,12 @@ double CatchStatistics::calcLikSumSquares() {
 	switch (functionnumber) {
 	case 6:
           ps.calcStatistics((*alptr)[area], lengr);
-	  (*modelMean[timeindex])[area][lengr] = ps.meanWeight();
+	  (*modelMean[modelindex])[area][lengr] = ps.meanWeight();
 	  simvar = (*obsStdDev[timeindex])[area][lengr] * (*obsStdDev[timeindex])[area][lengr];
           break;
         case 7:
           ps.calcStatistics((*alptr)[area], lengr);
-          (*modelMean[timeindex])[area][lengr] = ps.meanWeight();
+          (*modelMean[modelindex])[area][lengr] = ps.meanWeight();
           simvar = 1.0;
           break;
         default:
@@ -562,7 +573,7 @@ double CatchStatistics::calcLikSumSquares() {
 	}
 	
 	if (!(isZero(simvar))) {
-	  simdiff = (*modelMean[timeindex])[area][lengr] - (*obsMean[timeindex])[area][lengr];
+	  simdiff = (*modelMean[modelindex])[area][lengr] - (*obsMean[timeindex])[area][lengr];
 	  lik = simdiff * simdiff * (*numbers[timeindex])[area][lengr] / simvar;
 	  likelihoodValues[timeindex][area] += lik;
 	  
@@ -580,28 +591,28 @@ double CatchStatistics::calcLikSumSquares() {
 	switch (functionnumber) {
 	case 1:
 	  ps.calcStatistics((*alptr)[area][age], LgrpDiv, 0);
-	  (*modelMean[timeindex])[area][age] = ps.meanLength();
+	  (*modelMean[modelindex])[area][age] = ps.meanLength();
 	  simvar = ps.sdevLength() * ps.sdevLength();
-	  (*modelStdDev[timeindex])[area][age] = ps.sdevLength();
+	  (*modelStdDev[modelindex])[area][age] = ps.sdevLength();
 	  break;
 	case 2:
 	  ps.calcStatistics((*alptr)[area][age], LgrpDiv, 0);
-	  (*modelMean[timeindex])[area][age] = ps.meanLength();
+	  (*modelMean[modelindex])[area][age] = ps.meanLength();
 	  simvar = (*obsStdDev[timeindex])[area][age] * (*obsStdDev[timeindex])[area][age];
 	  break;
 	case 3:
 	  ps.calcStatistics((*alptr)[area][age], LgrpDiv);
-	  (*modelMean[timeindex])[area][age] = ps.meanWeight();
+	  (*modelMean[modelindex])[area][age] = ps.meanWeight();
 	  simvar = (*obsStdDev[timeindex])[area][age] * (*obsStdDev[timeindex])[area][age];
 	  break;
 	case 4:
 	  ps.calcStatistics((*alptr)[area][age], LgrpDiv);
-	  (*modelMean[timeindex])[area][age] = ps.meanWeight();
+	  (*modelMean[modelindex])[area][age] = ps.meanWeight();
 	  simvar = 1.0;
 	  break;
 	case 5:
 	  ps.calcStatistics((*alptr)[area][age], LgrpDiv, 0);
-	  (*modelMean[timeindex])[area][age] = ps.meanLength();
+	  (*modelMean[modelindex])[area][age] = ps.meanLength();
 	  simvar = 1.0;
 	  break;
 	default:
@@ -610,7 +621,7 @@ double CatchStatistics::calcLikSumSquares() {
 	}
 	  
 	if (!(isZero(simvar))) {
-	  simdiff = (*modelMean[timeindex])[area][age] - (*obsMean[timeindex])[area][age];
+	  simdiff = (*modelMean[modelindex])[area][age] - (*obsMean[timeindex])[area][age];
 	  lik = simdiff * simdiff * (*numbers[timeindex])[area][age] / simvar;
 	  likelihoodValues[timeindex][area] += lik;
 	}
@@ -0,0 +1,156 @@
+#include "checkpoint.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+//JMB this is used to check that a checkpoint file is for the same model
+static const int checkversion = 2;
+
+Checkpoint::Checkpoint(const char* const filename, int numiter, const ParameterVector& switches,
+  int numopt) : interval(numiter) {
+
+  int i, j;
+  lasteval = 0;
+  resuming = 0;
+  checkfile = new char[strlen(filename) + 1];
+  strcpy(checkfile, filename);
+  tmpfile = new char[strlen(filename) + 5];
+  strcpy(tmpfile, filename);
+  strcat(tmpfile, ".tmp");
+
+  //JMB this is the FNV-1a hash function
+  signature = 2166136261U;
+  for (i = 0; i < switches.Size(); i++) {
+    for (j = 0; j <= (int)strlen(switches[i].getName()); j++) {
+      signature ^= (unsigned char)switches[i].getName()[j];
+      signature *= 16777619U;
+    }
+  }
+  signature ^= (unsigned int)numopt;
+  signature *= 16777619U;
+}
+
+Checkpoint::~Checkpoint() {
+  delete[] checkfile;
+  delete[] tmpfile;
+}
+
+void Checkpoint::openWrite(int funceval) {
+  lasteval = funceval;
+  outfile.open(tmpfile, ios::out | ios::trunc | ios::binary);
+  handle.checkIfFailure(outfile, tmpfile);
+  this->write(checkversion);
+  outfile.write((const char*)&signature, sizeof(unsigned int));
+  this->write(interval);
+}
+
+void Checkpoint::closeWrite() {
+  outfile.flush();
+  if (outfile.fail())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - failed to write to file", tmpfile);
+  outfile.close();
+  outfile.clear();
+
+  //JMB only replace the previous file once the new file is complete
+  if (rename(tmpfile, checkfile) != 0)
+    handle.logMessage(LOGFAIL, "Error in checkpoint - failed to rename file", tmpfile);
+  handle.logMessage(LOGMESSAGE, "Saved the state of the optimisation to file", checkfile);
+}
+
+void Checkpoint::openRead(const char* const filename) {
+  int version;
+  unsigned int sig;
+
+  infile.open(filename, ios::in | ios::binary);
+  if (infile.fail()) {
+    //JMB the run was stopped before the state was saved, so start from the beginning
+    handle.logMessage(LOGWARN, "Warning in checkpoint - failed to open file, starting the optimisation from the beginning", filename);
+    infile.clear();
+    return;
+  }
+  handle.logMessage(LOGMESSAGE, "Reading the state of the optimisation from file", filename);
+  infile.read((char*)&version, sizeof(int));
+  infile.read((char*)&sig, sizeof(unsigned int));
+  if ((infile.fail()) || (version != checkversion) || (sig != signature))
+    handle.logMessage(LOGFAIL, "Error in checkpoint - file does not match current model", filename);
+
+  //JMB the state must be saved at the same points to continue the run exactly
+  this->read(interval);
+  resuming = 1;
+}
+
+void Checkpoint::closeRead(int funceval) {
+  lasteval = funceval;
+  resuming = 0;
+  infile.close();
+  infile.clear();
+  handle.logMessage(LOGINFO, "Continuing the optimisation after", funceval, "function evaluations");
+}
+
+void Checkpoint::write(int value) {
+  outfile.write((const char*)&value, sizeof(int));
+}
+
+void Checkpoint::write(double value) {
+  outfile.write((const char*)&value, sizeof(double));
+}
+
+void Checkpoint::write(const IntVector& vec) {
+  int i;
+  this->write(vec.Size());
+  for (i = 0; i < vec.Size(); i++)
+    this->write(vec[i]);
+}
+
+void Checkpoint::write(const DoubleVector& vec) {
+  int i;
+  this->write(vec.Size());
+  for (i = 0; i < vec.Size(); i++)
+    this->write(vec[i]);
+}
+
+void Checkpoint::write(const DoubleMatrix& mat) {
+  int i;
+  this->write(mat.Nrow());
+  for (i = 0; i < mat.Nrow(); i++)
+    this->write(mat[i]);
+}
+
+void Checkpoint::read(int& value) {
+  infile.read((char*)&value, sizeof(int));
+  if (infile.fail())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - failed to read from file");
+}
+
+void Checkpoint::read(double& value) {
+  infile.read((char*)&value, sizeof(double));
+  if (infile.fail())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - failed to read from file");
+}
+
+void Checkpoint::read(IntVector& vec) {
+  int i, size;
+  this->read(size);
+  if (size != vec.Size())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - received vector of the wrong size");
+  for (i = 0; i < vec.Size(); i++)
+    this->read(vec[i]);
+}
+
+void Checkpoint::read(DoubleVector& vec) {
+  int i, size;
+  this->read(size);
+  if (size != vec.Size())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - received vector of the wrong size");
+  for (i = 0; i < vec.Size(); i++)
+    this->read(vec[i]);
+}
+
+void Checkpoint::read(DoubleMatrix& mat) {
+  int i, size;
+  this->read(size);
+  if (size != mat.Nrow())
+    handle.logMessage(LOGFAIL, "Error in checkpoint - received matrix of the wrong size");
+  for (i = 0; i < mat.Nrow(); i++)
+    this->read(mat[i]);
+}
@@ -81,6 +81,24 @@ ConversionIndex::ConversionIndex(const LengthGroupDivision* const L1,
   for (i = maxlength; i < nf; i++)
     pos[i] = nc;
 
+  //create the conversion map from the source length groups to the target length groups
+  //there is one entry for each of the finer length groups, so no branches are needed to use it
+  from.resize(nf, 0);
+  to.resize(nf, 0);
+  weight.resize(nf, 1.0);
+  for (i = 0; i < nf; i++) {
+    if (samedl) {
+      from[i] = i;
+      to[i] = i + offset;
+    } else if (isfiner) {
+      from[i] = pos[i];
+      to[i] = i;
+    } else {
+      from[i] = i;
+      to[i] = pos[i];
+    }
+  }
+
   //if minpos and maxpos are needed
   if (!samedl) {
     minpos.resize(nc, nf - 1); //initialised to Lf->Size() - 1
@@ -104,8 +122,10 @@ ConversionIndex::ConversionIndex(const LengthGroupDivision* const L1,
     //if number in each length group is needed
     if (isfiner) {
       numpos.resize(nf, 1);
-      for (i = minlength; i < maxlength; i++)
+      for (i = minlength; i < maxlength; i++) {
         numpos[i] = maxpos[pos[i]] - minpos[pos[i]] + 1;
+        weight[i] = 1.0 / numpos[i];  //JMB numpos should never be zero
+      }
     }
 
     //if the conversionindex is to be used for interpolation
@@ -140,6 +160,27 @@ ConversionIndex::ConversionIndex(const LengthGroupDivision* const L1,
   }
 }
 
+//The function finds the entries in the conversion map between the source
+//length groups [mins, maxs) and the target length groups [mint, maxt)
+void ConversionIndex::getRange(int mint, int maxt, int mins, int maxs, int& first, int& last) const {
+  if (samedl) {
+    first = max(mint - offset, mins);
+    last = min(maxt - offset, maxs);
+  } else if (isfiner) {
+    first = max(mint, minpos[mins]);
+    last = min(maxt, maxpos[maxs - 1] + 1);
+  } else {
+    first = max(minpos[mint], mins);
+    last = min(maxpos[maxt - 1] + 1, maxs);
+  }
+
+  //JMB check that the entries at the ends of the range are inside both length groups
+  while ((first < last) && ((from[first] < mins) || (to[first] < mint)))
+    first++;
+  while ((first < last) && ((from[last - 1] >= maxs) || (to[last - 1] >= maxt)))
+    last--;
+}
+
 //The function interpolates values calculated on a coarse length distribution
 //Vc to a finer length distribution Vf using the conversionindex CI
 void ConversionIndex::interpolateLengths(DoubleVector& Vf, const DoubleVector& Vc) {
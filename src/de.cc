@@ -0,0 +1,205 @@
+#include "errorhandler.h"
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublematrix.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+/* JMB this is the DE/rand/1/bin version of the differential evolution      */
+/* algorithm from Differential Evolution - A Simple and Efficient Heuristic */
+/* for Global Optimization over Continuous Spaces by Rainer Storn and       */
+/* Kenneth Price, published in the Journal of Global Optimization, 1997     */
+
+/* All the random numbers for a generation are drawn before any of the      */
+/* trial points are evaluated, so the points that are evaluated depend only */
+/* on the seed and not on the number of processes used to evaluate them     */
+
+extern Ecosystem* EcoSystem;
+
+void OptInfoDE::OptimiseLikelihood() {
+
+  double tmp, bestf, worstf;
+  int i, j, k, r1, r2, r3, offset;
+
+  handle.logMessage(LOGINFO, "\nStarting Differential Evolution optimisation algorithm\n");
+  int nvars = EcoSystem->numOptVariables();
+  DoubleVector x(nvars);
+  DoubleVector bestx(nvars);
+  DoubleVector scalex(nvars);
+  DoubleVector init(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector popf(popsize, 0.0);
+  DoubleVector trialf(popsize, 0.0);
+  DoubleMatrix pop(popsize, nvars, 0.0);
+  DoubleMatrix trialpop(popsize, nvars, 0.0);
+
+  if (EcoSystem->isResuming()) {
+    //JMB continue the optimisation from the state that has been saved
+    Checkpoint* check = EcoSystem->getCheckpoint();
+    check->read(pop);
+    check->read(popf);
+    check->read(bestx);
+    check->read(init);
+    check->read(lowerb);
+    check->read(upperb);
+    check->read(bestf);
+    check->read(offset);
+    check->closeRead(EcoSystem->getFuncEval());
+
+  } else {
+    EcoSystem->scaleVariables();  //JMB need to scale variables
+    EcoSystem->getOptScaledValues(x);
+    EcoSystem->getOptLowerBounds(lowerb);
+    EcoSystem->getOptUpperBounds(upperb);
+    EcoSystem->getOptInitialValues(init);
+
+    for (i = 0; i < nvars; i++) {
+      // Scaling the bounds, because the parameters are scaled
+      lowerb[i] = lowerb[i] / init[i];
+      upperb[i] = upperb[i] / init[i];
+      if (lowerb[i] > upperb[i]) {
+        tmp = lowerb[i];
+        lowerb[i] = upperb[i];
+        upperb[i] = tmp;
+      }
+      bestx[i] = x[i];
+    }
+
+    bestf = EcoSystem->SimulateAndUpdate(x);
+    if (bestf != bestf) { //check for NaN
+      handle.logMessage(LOGINFO, "Error starting Differential Evolution optimisation with f(x) = infinity");
+      converge = -1;
+      iters = 1;
+      return;
+    }
+
+    offset = EcoSystem->getFuncEval();  //number of function evaluations done before loop
+
+    //JMB the first member of the population is the starting point, and the
+    //other members are chosen at random from within the bounds
+    DoubleVector tmpf(popsize - 1, 0.0);
+    DoubleMatrix tmppop(popsize - 1, nvars, 0.0);
+    for (k = 0; k < popsize - 1; k++)
+      for (i = 0; i < nvars; i++)
+        tmppop[k][i] = lowerb[i] + (upperb[i] - lowerb[i]) * randomNumber();
+
+    EcoSystem->SimulateAndUpdateBatch(tmppop, tmpf);
+    pop[0] = x;
+    popf[0] = bestf;
+    for (k = 1; k < popsize; k++) {
+      pop[k] = tmppop[k - 1];
+      popf[k] = tmpf[k - 1];
+    }
+  }
+
+  while (1) {
+    if (EcoSystem->checkpointDue()) {
+      Checkpoint* check = EcoSystem->writeCheckpoint();
+      check->write(pop);
+      check->write(popf);
+      check->write(bestx);
+      check->write(init);
+      check->write(lowerb);
+      check->write(upperb);
+      check->write(bestf);
+      check->write(offset);
+      check->closeWrite();
+    }
+
+    //JMB check the population for a new optimum
+    j = -1;
+    worstf = bestf;
+    for (k = 0; k < popsize; k++) {
+      if (popf[k] < bestf) {
+        bestf = popf[k];
+        j = k;
+      }
+      if ((popf[k] > worstf) || (popf[k] != popf[k]))
+        worstf = popf[k];
+    }
+
+    iters = EcoSystem->getFuncEval() - offset;
+    if (j != -1) {
+      for (i = 0; i < nvars; i++) {
+        bestx[i] = pop[j][i];
+        scalex[i] = bestx[i] * init[i];
+      }
+
+      EcoSystem->storeVariables(bestf, scalex);
+      handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The likelihood score is", bestf, "at the point");
+      EcoSystem->writeBestValues();
+    }
+
+    if (isZero(bestf)) {
+      handle.logMessage(LOGINFO, "Error in Differential Evolution optimisation after", iters, "function evaluations, f(x) = 0");
+      converge = -1;
+      return;
+    }
+
+    // terminate the algorithm if the population has converged
+    if (fabs(worstf - bestf) < deeps) {
+      handle.logMessage(LOGINFO, "\nStopping Differential Evolution optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+
+      converge = 1;
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nDifferential Evolution finished with a likelihood score of", score);
+      return;
+    }
+
+    // terminate the algorithm if too many function evaluations occur
+    if (iters > deiter) {
+      handle.logMessage(LOGINFO, "\nStopping Differential Evolution optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+      handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nDifferential Evolution finished with a likelihood score of", score);
+      return;
+    }
+
+    //JMB create the trial point for each member of the population
+    for (k = 0; k < popsize; k++) {
+      do {
+        r1 = rand() % popsize;
+      } while (r1 == k);
+      do {
+        r2 = rand() % popsize;
+      } while ((r2 == k) || (r2 == r1));
+      do {
+        r3 = rand() % popsize;
+      } while ((r3 == k) || (r3 == r1) || (r3 == r2));
+
+      //JMB at least one parameter is always taken from the difference
+      j = rand() % nvars;
+      for (i = 0; i < nvars; i++) {
+        if ((i == j) || (randomNumber() < crossover)) {
+          trialpop[k][i] = pop[r1][i] + weight * (pop[r2][i] - pop[r3][i]);
+
+          //JMB move any parameter that is outside the bounds back between the bound and the current point
+          if (trialpop[k][i] < lowerb[i])
+            trialpop[k][i] = 0.5 * (lowerb[i] + pop[k][i]);
+          else if (trialpop[k][i] > upperb[i])
+            trialpop[k][i] = 0.5 * (upperb[i] + pop[k][i]);
+        } else
+          trialpop[k][i] = pop[k][i];
+      }
+    }
+
+    //JMB the trial points are independent so they can be evaluated concurrently
+    EcoSystem->SimulateAndUpdateBatch(trialpop, trialf);
+
+    //JMB keep the trial point if it is at least as good as the current member
+    for (k = 0; k < popsize; k++) {
+      if ((trialf[k] <= popf[k]) || (popf[k] != popf[k])) {
+        pop[k] = trialpop[k];
+        popf[k] = trialf[k];
+      }
+    }
+  }
+}
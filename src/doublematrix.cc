@@ -80,6 +80,12 @@ void DoubleMatrix::Delete(int pos) {
 
 DoubleMatrix& DoubleMatrix::operator = (const DoubleMatrix& d) {
   int i;
+  if (nrow == d.nrow) {
+    //JMB reuse the existing memory when the number of rows is the same
+    for (i = 0; i < nrow; i++)
+      (*v[i]) = d[i];
+    return *this;
+  }
   if (v != 0) {
     for (i = 0; i < nrow; i++)
       delete v[i];
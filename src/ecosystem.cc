@@ -1,12 +1,20 @@
 #include "ecosystem.h"
+#include "boundlikelihood.h"
+#include "ludecomposition.h"
 #include "runid.h"
 #include "global.h"
 
-Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
+Ecosystem::Ecosystem(const MainInfo& main, int nosubsteps) : printinfo(main.getPI()) {
 
   funceval = 0;
   interrupted = 0;
   likelihood = 0.0;
+  numcores = main.getNumCores();
+  cachehit = 0;
+  cache = 0;
+  checkpoint = 0;
+  curopt = 0;
+  status = 0;
   keeper = new Keeper;
 
   // initialise counter used when printing output files
@@ -18,12 +26,20 @@ Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
   infile.open(filename, ios::in);
   CommentStream commin(infile);
   handle.checkIfFailure(infile, filename);
+  //JMB the contents of the input files are used to check stored likelihood scores
+  handle.setHashFiles(1);
   handle.Open(filename);
-  this->readMain(commin, main);
+  this->readMain(commin, main, nosubsteps);
   handle.Close();
+  handle.setHashFiles(0);
+  modelhash = handle.getFileHash();
   infile.close();
   infile.clear();
 
+  //JMB the model without substeps is only used to find a starting point for the full model
+  if (nosubsteps)
+    printinfo.setPrint(0);
+
   // if this is an optimising run then read the optimisation parameters from file
   if (main.runOptimise()) {
     handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
@@ -62,6 +78,12 @@ Ecosystem::~Ecosystem() {
   for (i = 0; i < basevec.Size(); i++)
     delete basevec[i];
 
+  if (cache != 0)
+    delete cache;
+  if (checkpoint != 0)
+    delete checkpoint;
+  if (status != 0)
+    delete status;
   delete Area;
   delete TimeInfo;
   delete keeper;
@@ -99,17 +121,127 @@ void Ecosystem::Reset() {
 }
 
 void Ecosystem::Optimise() {
-  int i;
-  for (i = 0; i < optvec.Size(); i++) {
+  int i, start;
+  start = 0;
+  if (this->isResuming())
+    start = this->readCheckpoint();
+
+  for (i = start; i < optvec.Size(); i++) {
+    curopt = i;
+    if (status != 0) {
+      switch (optvec[i]->getType()) {
+        case OPTHOOKE:
+          status->setPhase("hooke");
+          break;
+        case OPTSIMANN:
+          status->setPhase("simann");
+          break;
+        case OPTBFGS:
+          status->setPhase("bfgs");
+          break;
+        case OPTLBFGS:
+          status->setPhase("lbfgs");
+          break;
+        case OPTDE:
+          status->setPhase("de");
+          break;
+        default:
+          status->setPhase("optimising");
+          break;
+      }
+    }
     optvec[i]->OptimiseLikelihood();
     this->writeOptValues();
   }
+
+  if (checkpoint != 0) {
+    //JMB save the final state so that a finished run will not be repeated
+    curopt = optvec.Size();
+    this->writeCheckpoint();
+    checkpoint->closeWrite();
+  }
+
+  if (cache != 0) {
+    handle.logMessage(LOGINFO, "\nThe stored likelihood scores were used for", cache->numHits(), "function evaluations");
+    //JMB the model needs to be simulated if the last point was found in the cache
+    if (cachehit)
+      this->Simulate(0);
+    cachehit = 0;
+  }
 }
 
-double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+void Ecosystem::createCache(int size, const char* const filename) {
+  ParameterVector switches(keeper->numVariables());
+  keeper->getSwitches(switches);
+  cache = new LikelihoodCache(size, switches, likevec, modelhash);
+  if (cachescores.Size() == 0)
+    cachescores.resize(likevec.Size() + 1, 0.0);
+  if (filename != NULL)
+    cache->openFile(filename);
+}
+
+void Ecosystem::createStatus(const char* const filename) {
+  status = new StatusBlock(filename, likevec);
+  if (cachescores.Size() == 0)
+    cachescores.resize(likevec.Size() + 1, 0.0);
+}
+
+void Ecosystem::createCheckpoint(const char* const filename, int interval, const char* const resumefile) {
+  ParameterVector switches(keeper->numVariables());
+  keeper->getSwitches(switches);
+  checkpoint = new Checkpoint(filename, interval, switches, optvec.Size());
+  if (resumefile != NULL)
+    checkpoint->openRead(resumefile);
+}
+
+Checkpoint* Ecosystem::writeCheckpoint() {
+  int i, seed;
+
+  //JMB reseed the random number generator so that a run that is continued
+  //from this point will use the same random numbers as this run
+  seed = rand();
+  srand(seed);
+
+  checkpoint->openWrite(funceval);
+  checkpoint->write(curopt);
+  checkpoint->write(funceval);
+  checkpoint->write(printcount);
+  checkpoint->write(likelihood);
+  checkpoint->write(seed);
+  keeper->writeCheckpoint(checkpoint);
+  for (i = 0; i < curopt; i++)
+    optvec[i]->writeCheckpoint(checkpoint);
+  return checkpoint;
+}
+
+int Ecosystem::readCheckpoint() {
+  int i, seed;
+
+  checkpoint->read(curopt);
+  checkpoint->read(funceval);
+  checkpoint->read(printcount);
+  checkpoint->read(likelihood);
+  checkpoint->read(seed);
+  if ((curopt < 0) || (curopt > optvec.Size()))
+    handle.logMessage(LOGFAIL, "Error in checkpoint - invalid optimisation algorithm", curopt);
+
+  srand(seed);
+  keeper->readCheckpoint(checkpoint);
+  for (i = 0; i < curopt; i++)
+    optvec[i]->readCheckpoint(checkpoint);
+
+  if (curopt == optvec.Size()) {
+    //JMB the optimisation had finished so the model needs to be simulated at the final point
+    checkpoint->closeRead(funceval);
+    this->Simulate(0);
+  }
+  return curopt;
+}
+
+void Ecosystem::updateOptValues(const DoubleVector& x) {
   int i, j;
 
-  if (funceval == 0) {
+  if (optflag.Size() != keeper->numVariables()) {
     // JMB - only need to create these vectors once
     initialval.resize(keeper->numVariables(), 0.0);
     currentval.resize(keeper->numVariables(), 0.0);
@@ -128,8 +260,50 @@ double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
   }
 
   keeper->Update(currentval);
-  this->Simulate(0);  //dont print whilst optimising
+}
+
+double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+  int i;
+  this->updateOptValues(x);
+
+  if ((cache != 0) && (cache->findPoint(currentval, cachescores))) {
+    //JMB this point has already been evaluated so use the stored scores
+    cachehit = 1;
+    this->restoreScores(cachescores);
+
+  } else {
+    cachehit = 0;
+    this->Simulate(0);  //dont print whilst optimising
+    if ((cache != 0) || (status != 0)) {
+      cachescores[0] = likelihood;
+      for (i = 0; i < likevec.Size(); i++)
+        cachescores[i + 1] = likevec[i]->getUnweightedLikelihood();
+      if (cache != 0)
+        cache->storePoint(currentval, cachescores);
+    }
+  }
+
+  this->printOptValues();
+  funceval++;
+  if (status != 0)
+    status->Update(funceval, cachescores);
+  return likelihood;
+}
 
+void Ecosystem::restoreScores(const DoubleVector& scores) {
+  int i;
+  //JMB the model hasnt been simulated here, so move the parameters back to
+  //the bounds in the same way that the simulation would have done
+  for (i = 0; i < likevec.Size(); i++)
+    if (likevec[i]->getType() == BOUNDLIKELIHOOD)
+      ((BoundLikelihood*)likevec[i])->resetValues(keeper);
+
+  likelihood = scores[0];
+  for (i = 0; i < likevec.Size(); i++)
+    likevec[i]->setUnweightedLikelihood(scores[i + 1]);
+}
+
+void Ecosystem::printOptValues() {
   if (printinfo.getPrint()) {
     printcount++;
     if (printcount == printinfo.getPrintIteration()) {
@@ -137,9 +311,250 @@ double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
       printcount = 0;
     }
   }
+}
 
-  funceval++;
-  return likelihood;
+#ifdef NOT_WINDOWS
+static int readScore(int fd, double& score) {
+  char* ptr = (char*)&score;
+  int left = sizeof(double);
+  int num;
+  while (left > 0) {
+    num = read(fd, ptr, left);
+    if (num <= 0)
+      return 0;
+    ptr += num;
+    left -= num;
+  }
+  return 1;
+}
+
+static int writeScore(int fd, double score) {
+  char* ptr = (char*)&score;
+  int left = sizeof(double);
+  int num;
+  while (left > 0) {
+    num = write(fd, ptr, left);
+    if (num <= 0)
+      return 0;
+    ptr += num;
+    left -= num;
+  }
+  return 1;
+}
+#endif
+
+void Ecosystem::SimulateAndUpdateBatch(const DoubleMatrix& x, DoubleVector& scores) {
+  int k;
+  int npoints = x.Nrow();
+  int nprocs = min(numcores, npoints);
+
+  if (scores.Size() != npoints)
+    handle.logMessage(LOGFAIL, "Error in ecosystem - received invalid number of points to evaluate");
+
+  if (nprocs < 2) {
+    for (k = 0; k < npoints; k++)
+      scores[k] = this->SimulateAndUpdate(x[k]);
+    return;
+  }
+
+#ifdef NOT_WINDOWS
+  //JMB check for any points that have already been evaluated
+  int j;
+  IntVector pending;
+  IntVector found(npoints, 0);
+  DoubleMatrix allscores(npoints, likevec.Size() + 1, 0.0);
+  for (k = 0; k < npoints; k++) {
+    this->updateOptValues(x[k]);
+    if ((cache != 0) && (cache->findPoint(currentval, allscores[k])))
+      found[k] = 1;
+    else
+      pending.resize(1, k);
+  }
+
+  int numpending = pending.Size();
+  DoubleMatrix tmpscores(numpending, likevec.Size() + 1, 0.0);
+  IntVector done(numpending, 0);
+  this->simulateInChildren(x, pending, tmpscores, done);
+  for (j = 0; j < numpending; j++) {
+    if (done[j]) {
+      k = pending[j];
+      allscores[k] = tmpscores[j];
+      found[k] = 2;
+    }
+  }
+
+  //JMB the results are used in the same order as the points, as for a single core
+  for (k = 0; k < npoints; k++) {
+    if (!found[k]) {
+      //JMB something went wrong with the child process so evaluate this point here
+      scores[k] = this->SimulateAndUpdate(x[k]);
+      continue;
+    }
+
+    this->updateOptValues(x[k]);
+    if ((cache != 0) && (found[k] == 2))
+      cache->storePoint(currentval, allscores[k]);
+    this->restoreScores(allscores[k]);
+    scores[k] = likelihood;
+
+    this->printOptValues();
+    funceval++;
+    if (status != 0)
+      status->Update(funceval, allscores[k]);
+  }
+#else
+  for (k = 0; k < npoints; k++)
+    scores[k] = this->SimulateAndUpdate(x[k]);
+#endif
+}
+
+void Ecosystem::SimulatePoints(const DoubleMatrix& x, DoubleMatrix& scores) {
+  int i, k;
+  if (scores.Nrow() != x.Nrow())
+    handle.logMessage(LOGFAIL, "Error in ecosystem - received invalid number of points to evaluate");
+
+  //JMB this is called by a server process, and the server already has one
+  //process for each core, so the points are evaluated one after another
+  for (k = 0; k < x.Nrow(); k++) {
+    keeper->Update(x[k]);
+    this->Simulate(0);
+    scores[k][0] = likelihood;
+    for (i = 0; i < likevec.Size(); i++)
+      scores[k][i + 1] = likevec[i]->getUnweightedLikelihood();
+  }
+}
+
+void Ecosystem::simulateInChildren(const DoubleMatrix& x, const IntVector& points,
+  DoubleMatrix& scores, IntVector& done) {
+
+#ifdef NOT_WINDOWS
+  int c, i, j, check, fd[2];
+  pid_t pid;
+  int numpoints = points.Size();
+  int nprocs = min(numcores, numpoints);
+  IntVector pids(nprocs, -1);
+  IntVector pipes(nprocs, -1);
+
+  //JMB each child process evaluates every nprocs-th point on its own copy of
+  //the model and sends the likelihood scores back through a pipe, in order
+  cout.flush();
+  cerr.flush();
+  for (c = 0; c < nprocs; c++) {
+    if (pipe(fd) != 0)
+      break;
+
+    pid = fork();
+    if (pid == 0) {
+      //JMB this is the child process - it must not write any output
+      signal(SIGINT, SIG_IGN);
+      signal(SIGTSTP, SIG_IGN);
+      handle.setLogLevel(1);
+      close(fd[0]);
+      for (j = c; j < numpoints; j += nprocs) {
+        this->updateOptValues(x[points[j]]);
+        this->Simulate(0);
+        check = writeScore(fd[1], likelihood);
+        for (i = 0; i < likevec.Size(); i++)
+          check = check && writeScore(fd[1], likevec[i]->getUnweightedLikelihood());
+        if (!check)
+          _exit(EXIT_FAILURE);
+      }
+      close(fd[1]);
+      _exit(EXIT_SUCCESS);
+    }
+
+    close(fd[1]);
+    if (pid < 0) {
+      close(fd[0]);
+      break;
+    }
+    pids[c] = pid;
+    pipes[c] = fd[0];
+  }
+
+  for (c = 0; c < nprocs; c++) {
+    check = (pids[c] > 0);
+    for (j = c; j < numpoints; j += nprocs) {
+      if (check) {
+        for (i = 0; i < scores.Ncol(j); i++)
+          if ((check) && (!readScore(pipes[c], scores[j][i])))
+            check = 0;
+        if (!check)
+          handle.logMessage(LOGWARN, "Warning in ecosystem - failed to get likelihood score from child process");
+      }
+      done[j] = check;
+    }
+
+    if (pids[c] > 0) {
+      close(pipes[c]);
+      waitpid(pids[c], NULL, 0);
+    }
+  }
+#endif
+}
+
+void Ecosystem::calcHessian(const char* const filename, int prec) {
+  int i, j, eval;
+  int nvars = keeper->numOptVariables();
+
+  if (nvars == 0) {
+    handle.logMessage(LOGWARN, "Warning - no parameters to calculate the Hessian matrix for");
+    return;
+  }
+
+  handle.logMessage(LOGINFO, "\nCalculating the Hessian matrix at the final point");
+  if (status != 0)
+    status->setPhase("hessian");
+  //JMB use the BFGS gradient settings for the step lengths, if they have been specified
+  OptInfoBFGS* bfgs = 0;
+  for (i = 0; i < optvec.Size(); i++)
+    if (optvec[i]->getType() == OPTBFGS)
+      bfgs = (OptInfoBFGS*)optvec[i];
+  OptInfoBFGS defaultbfgs;
+  if (bfgs == 0)
+    bfgs = &defaultbfgs;
+
+  DoubleVector x(nvars, 0.0);
+  DoubleVector init(nvars, 0.0);
+  DoubleMatrix hess(nvars, nvars, 0.0);
+  DoubleMatrix invhess;
+
+  //JMB the function evaluations for the Hessian are not part of the optimisation
+  eval = funceval;
+  keeper->scaleVariables();
+  keeper->getOptScaledValues(x);
+  keeper->getOptInitialValues(init);
+  double f = this->SimulateAndUpdate(x);
+  bfgs->hessian(x, f, hess);
+
+  //JMB the Hessian has been calculated for the scaled parameters
+  for (i = 0; i < nvars; i++)
+    for (j = 0; j < nvars; j++)
+      hess[i][j] /= (init[i] * init[j]);
+
+  handle.logMessage(LOGINFO, "The Hessian matrix was calculated after", funceval - eval, "function evaluations");
+
+  //JMB make sure that the model is left at the final point
+  this->updateOptValues(x);
+  this->Simulate(0);
+  funceval = eval;
+
+  LUDecomposition LU(hess);
+  if (LU.isIllegal()) {
+    handle.logMessage(LOGWARN, "Warning - the Hessian matrix is not positive definite and cannot be inverted");
+  } else {
+    DoubleVector unit(nvars, 0.0);
+    invhess.AddRows(nvars, nvars, 0.0);
+    for (j = 0; j < nvars; j++) {
+      unit[j] = 1.0;
+      DoubleVector col(LU.Solve(unit));
+      for (i = 0; i < nvars; i++)
+        invhess[i][j] = col[i];
+      unit[j] = 0.0;
+    }
+  }
+
+  keeper->writeHessian(filename, hess, invhess, f, prec);
 }
 
 void Ecosystem::writeOptValues() {
@@ -12,6 +12,8 @@ ErrorHandler::ErrorHandler() {
   numwarn = 0;
   runopt = 0;
   nanflag = 0;
+  hashfiles = 0;
+  filehash = 2166136261U;
   loglevel = LOGINFO;
 }
 
@@ -70,6 +72,29 @@ void ErrorHandler::setLogFile(const char* filename) {
 void ErrorHandler::Open(const char* filename) {
   this->logMessage(LOGMESSAGE, "Opening file", filename);
   files->storeString(filename);
+
+  if (hashfiles) {
+    //JMB include the contents of the file in the FNV-1a hash of the input files
+    int i, size;
+    char buffer[4096];
+    ifstream infile(filename, ios::in | ios::binary);
+    while (!infile.fail()) {
+      infile.read(buffer, sizeof(buffer));
+      size = infile.gcount();
+      for (i = 0; i < size; i++) {
+        filehash ^= (unsigned char)buffer[i];
+        filehash *= 16777619U;
+      }
+    }
+    infile.close();
+    infile.clear();
+  }
+}
+
+void ErrorHandler::setHashFiles(int flag) {
+  hashfiles = flag;
+  if (hashfiles)
+    filehash = 2166136261U;
 }
 
 void ErrorHandler::Close() {
@@ -116,4 +116,8 @@ void FleetPreyAggregator::Sum() {
       }
     }
   }
+
+  //JMB calculate the mean weights now that the population has been summed
+  for (r = 0; r < total.Size(); r++)
+    total[r].finaliseSum();
 }
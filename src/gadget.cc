@@ -4,11 +4,24 @@
 #include "gadget.h"
 #include "errorhandler.h"
 #include "stochasticdata.h"
+#include "modelserver.h"
 #include "interrupthandler.h"
 #include "global.h"
 
 Ecosystem* EcoSystem;
 
+//JMB read the values of the parameters for each scenario and then simulate the projection
+static void projectModel(const MainInfo& main, const char* const inputdir, const char* const workingdir) {
+  StochasticData* scenarios;
+  if (chdir(inputdir) != 0) //JMB need to change back to inputdir to read the file
+    handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
+  scenarios = new StochasticData(main.getProjectionFile());
+  if (chdir(workingdir) != 0)
+    handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+
+  EcoSystem->Project(scenarios, main.getProjectionYear(), main.runPrint());
+  delete scenarios;
+}
 
 int main(int aNumber, char* const aVector[]) {
 
@@ -51,8 +64,8 @@ int main(int aNumber, char* const aVector[]) {
   EcoSystem = new Ecosystem(main);
 
 #ifdef INTERRUPT_HANDLER
-  //JMB dont register interrupt if doing a network run
-  if (!(main.runNetwork()))
+  //JMB dont register interrupt if doing a network run or running as a server
+  if ((!(main.runNetwork())) && (!(main.runServer())))
     registerInterrupts(&EcoSystem->interrupted);
 #endif
 
@@ -60,9 +73,39 @@ int main(int aNumber, char* const aVector[]) {
     handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
   if ((main.getPI()).getPrint())
     EcoSystem->writeInitialInformation((main.getPI()).getOutputFile());
+  if ((main.getCacheSize() > 0) && ((main.runOptimise()) || (main.runHessian())))
+    EcoSystem->createCache(main.getCacheSize(), main.getCacheFile());
+  if (main.getStatusFile() != NULL)
+    EcoSystem->createStatus(main.getStatusFile());
+  if ((main.getCheckpointFile() != NULL) && (main.runOptimise()))
+    EcoSystem->createCheckpoint(main.getCheckpointFile(), main.getCheckpointIter(), main.getResumeFile());
 
   if (main.runStochastic()) {
-    if (main.runNetwork()) {
+    if (main.runServer()) {
+      if (main.getInitialParamGiven()) {
+        if (chdir(inputdir) != 0) //JMB need to change back to inputdir to read the file
+          handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
+        data = new StochasticData(main.getInitialParamFile());
+        if (chdir(workingdir) != 0)
+          handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+
+        EcoSystem->Update(data);
+        EcoSystem->checkBounds();
+        delete data;
+      }
+
+      //JMB the model is only initialised once, and each worker process
+      //then gets its own copy of the initialised model to evaluate
+      EcoSystem->Initialise();
+      if (main.printInitial()) {
+        EcoSystem->Reset();  //JMB only need to call reset() before the print commands
+        EcoSystem->writeStatus(main.getPrintInitialFile());
+      }
+
+      ModelServer server(main.getServerFile(), main.getNumCores(), main.runPrint());
+      server.Serve();
+
+    } else if (main.runNetwork()) {
 #ifdef GADGET_NETWORK //to help compiling when pvm libraries are unavailable
       EcoSystem->Initialise();
       data = new StochasticData();
@@ -91,7 +134,10 @@ int main(int aNumber, char* const aVector[]) {
         EcoSystem->writeStatus(main.getPrintInitialFile());
       }
 
-      EcoSystem->Simulate(main.runPrint());
+      if (main.runProjection())
+        projectModel(main, inputdir, workingdir);
+      else
+        EcoSystem->Simulate(main.runPrint());
       if ((main.getPI()).getPrint())
         EcoSystem->writeValues();
 
@@ -115,7 +161,10 @@ int main(int aNumber, char* const aVector[]) {
         EcoSystem->writeStatus(main.getPrintInitialFile());
       }
 
-      EcoSystem->Simulate(main.runPrint());
+      if (main.runProjection())
+        projectModel(main, inputdir, workingdir);
+      else
+        EcoSystem->Simulate(main.runPrint());
       if ((main.getPI()).getPrint())
         EcoSystem->writeValues();
     }
@@ -133,7 +182,6 @@ int main(int aNumber, char* const aVector[]) {
 
       EcoSystem->Update(data);
       EcoSystem->checkBounds();
-      delete data;
     } else
       handle.logMessage(LOGFAIL, "Error - no parameter input file specified");
 
@@ -143,11 +191,57 @@ int main(int aNumber, char* const aVector[]) {
       EcoSystem->writeStatus(main.getPrintInitialFile());
     }
 
+    if ((main.runNoSubSteps()) && (!EcoSystem->isResuming()) && (!EcoSystem->hasSubSteps())) {
+      //JMB there are no substeps to remove so this would be the full model
+      handle.logMessage(LOGWARN, "Warning - none of the timesteps in the model are split into substeps\nGadget will skip the optimisation of the model without substeps");
+
+    } else if ((main.runNoSubSteps()) && (!EcoSystem->isResuming())) {
+      //JMB optimise the model without substeps first, and then continue
+      //with the optimisation of the full model from the best point found
+      Ecosystem* fullmodel = EcoSystem;
+      DoubleVector values(fullmodel->numVariables(), 0.0);
+
+      handle.logMessage(LOGINFO, "\nStarting optimisation of the model without substeps");
+      if (chdir(inputdir) != 0)
+        handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
+      EcoSystem = new Ecosystem(main, 1);
+      if (chdir(workingdir) != 0)
+        handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+#ifdef INTERRUPT_HANDLER
+      registerInterrupts(&EcoSystem->interrupted);
+#endif
+
+      EcoSystem->Update(data);
+      EcoSystem->Initialise();
+      EcoSystem->Optimise();
+      EcoSystem->getBestValues(values);
+      handle.logMessage(LOGINFO, "\nFinished optimisation of the model without substeps after", EcoSystem->getFuncEval(), "function evaluations");
+      handle.logMessage(LOGINFO, "Starting optimisation of the full model\n");
+
+      delete EcoSystem;
+      EcoSystem = fullmodel;
+#ifdef INTERRUPT_HANDLER
+      registerInterrupts(&EcoSystem->interrupted);
+#endif
+      EcoSystem->Update(values);
+      EcoSystem->checkBounds();
+    }
+    delete data;
+
     EcoSystem->Optimise();
     if (main.getForcePrint())
       EcoSystem->Simulate(main.getForcePrint());
   }
 
+  if (main.runHessian()) {
+    //JMB the Hessian information is written next to the final parameter file
+    char* hessianfile = new char[strlen((main.getPI()).getParamOutFile()) + 9];
+    strcpy(hessianfile, (main.getPI()).getParamOutFile());
+    strcat(hessianfile, ".hessian");
+    EcoSystem->calcHessian(hessianfile, (main.getPI()).getPrecision());
+    delete[] hessianfile;
+  }
+
   handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
   if (main.printFinal() && !(main.runNetwork()))
     EcoSystem->writeStatus(main.getPrintFinalFile());
@@ -1,4 +1,39 @@
 #include "runid.h"
 #include "errorhandler.h"
 RunID RUNID;
-ErrorHandler handle;
\ No newline at end of file
+ErrorHandler handle;
+
+#ifdef DEBUG
+#include <new>
+
+//JMB count every heap allocation so that the simulation can be checked
+static long allocations = 0;
+
+long numAllocations() {
+  return allocations;
+}
+
+void* operator new(size_t size) {
+  allocations++;
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == 0)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  allocations++;
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == 0)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) throw() {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) throw() {
+  free(ptr);
+}
+#endif
@@ -82,7 +82,6 @@ Grower::Grower(CommentStream& infile, const LengthGroupDivision* const OtherLgrp
 
     part1.resize(maxlengthgroupgrowth + 1, 0.0);
     part2.resize(maxlengthgroupgrowth + 1, 0.0);
-    part4.resize(maxlengthgroupgrowth + 1, 0.0);
 
   } else if (strcasecmp(text, "meanvarianceparameters") == 0) {
     handle.logFileMessage(LOGFAIL, "\nThe mean variance parameters implementation of the growth is no longer supported\nUse the beta-binomial distribution implementation of the growth instead");
@@ -104,10 +103,16 @@ Grower::Grower(CommentStream& infile, const LengthGroupDivision* const OtherLgrp
   interpLengthGrowth.AddRows(noareas, otherlen, 0.0);
   interpWeightGrowth.AddRows(noareas, otherlen, 0.0);
   dummyfphi.resize(len, 0.0);
+  lengthPower.resize(otherlen, 0.0);
   for (i = 0; i < noareas; i++) {
     lgrowth.resize(new DoubleMatrix(maxlengthgroupgrowth + 1, otherlen, 0.0));
     wgrowth.resize(new DoubleMatrix(maxlengthgroupgrowth + 1, otherlen, 0.0));
   }
+  lastGrowth.AddRows(noareas, otherlen, -1.0);
+  calcIndex.resize(otherlen, 0);
+  alpha.resize(otherlen, 0.0);
+  part3.resize(otherlen, 0.0);
+  part4.resize(otherlen, 0.0);
 }
 
 Grower::~Grower() {
@@ -201,6 +206,9 @@ void Grower::Reset() {
     (*lgrowth[area]).setToZero();
     for (i = 0; i < LgrpDiv->numLengthGroups(); i++)
       numGrow[area][i].setToZero();
+    //JMB the length distribution has been cleared so it will need to be recalculated
+    for (i = 0; i < lastGrowth.Ncol(area); i++)
+      lastGrowth[area][i] = -1.0;
   }
 
   switch (functionnumber) {
@@ -244,9 +252,6 @@ void Grower::Reset() {
     for (i = maxlengthgroupgrowth - 2; i >= 0; i--)
       part2[i] = part2[i + 1] * (beta + tmpmax - i - 1);
 
-  //JMB this will never change so we can set it once
-  part4[0] = 1.0;
-
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Reset grower data for stock", this->getName());
 }
@@ -1,5 +1,6 @@
 #include "grower.h"
 #include "mathfunc.h"
+#include "vectormath.h"
 #include "errorhandler.h"
 #include "global.h"
 
@@ -9,31 +10,17 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
   const LengthGroupDivision* const Lengths) {
 
   int lgroup, j, inarea = this->areaNum(area);
-  double meanw, tmppart3, tmpweight;
+  int numlen = Lengths->numLengthGroups();
+  double meanw, tmpweight;
   double tmpMult = growthcalc->getMult();
   double tmpPower = growthcalc->getPower();
-  double tmpDl = 1.0 / Lengths->dl();  //JMB no need to check zero here
 
-  for (lgroup = 0; lgroup < Lengths->numLengthGroups(); lgroup++) {
-    part3 = 1.0;
-    growth = interpLengthGrowth[inarea][lgroup] * tmpDl;
-    if (growth >= maxlengthgroupgrowth)
-      growth = double(maxlengthgroupgrowth) - 0.1;
-    if (growth < verysmall)
-      growth = 0.0;
-    alpha = beta * growth / (maxlengthgroupgrowth - growth);
-    for (j = 0; j < maxlengthgroupgrowth; j++)
-      part3 *= (alpha + beta + double(j));
-
-    tmppart3 = 1.0 / part3;
-    part4[1] = alpha;
-    if (maxlengthgroupgrowth > 1)
-      for (j = 2; j <= maxlengthgroupgrowth; j++)
-        part4[j] = part4[j - 1] * (j - 1 + alpha);
-
-    for (j = 0; j <= maxlengthgroupgrowth; j++)
-      (*lgrowth[inarea])[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[j];
+  //JMB calculate the power of the mean lengths once for all the length groups
+  if ((functionnumber == 8) || (functionnumber == 10) || (functionnumber == 11))
+    vpow(&lengthPower[0], &(Lengths->meanLengths())[0], tmpPower, numlen);
 
+  this->calcLengthDistribution(inarea, Lengths);
+  for (lgroup = 0; lgroup < numlen; lgroup++) {
     switch (functionnumber) {
       case 1:
       case 2:
@@ -57,9 +44,9 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
       case 8:
       case 10:
       case 11:
-        if (lgroup != Lengths->numLengthGroups())
+        if (lgroup != numlen)
           for (j = 1; j <= maxlengthgroupgrowth; j++)
-            (*wgrowth[inarea])[j][lgroup] = tmpMult * (pow(Lengths->meanLength(lgroup + j), tmpPower) - pow(Lengths->meanLength(lgroup), tmpPower));
+            (*wgrowth[inarea])[j][lgroup] = tmpMult * (lengthPower[min(lgroup + j, numlen - 1)] - lengthPower[lgroup]);
         break;
       default:
         handle.logMessage(LOGFAIL, "Error in grower - unrecognised growth function", functionnumber);
@@ -70,29 +57,70 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
 
 //Uses only the length increase in interpLengthGrowth to calculate lgrowth.
 void Grower::implementGrowth(int area, const LengthGroupDivision* const Lengths) {
+  this->calcLengthDistribution(this->areaNum(area), Lengths);
+}
 
-  int lgroup, j, inarea = this->areaNum(area);
-  double tmppart3;
+//Calculates the beta binomial distribution of the length increase in lgrowth.
+//The distribution for a length group only depends on the mean growth, so it is
+//only calculated when the mean growth has changed since the last timestep, and
+//it is copied from another area where the mean growth is the same
+void Grower::calcLengthDistribution(int inarea, const LengthGroupDivision* const Lengths) {
+
+  int lgroup, a, j, k, num;
+  double growth, tmp;
+  double tmpBeta = beta;
   double tmpDl = 1.0 / Lengths->dl();  //JMB no need to check zero here
+  DoubleMatrix& dist = *lgrowth[inarea];
 
+  num = 0;
   for (lgroup = 0; lgroup < Lengths->numLengthGroups(); lgroup++) {
-    part3 = 1.0;
     growth = interpLengthGrowth[inarea][lgroup] * tmpDl;
     if (growth >= maxlengthgroupgrowth)
       growth = double(maxlengthgroupgrowth) - 0.1;
     if (growth < verysmall)
       growth = 0.0;
-    alpha = beta * growth / (maxlengthgroupgrowth - growth);
-    for (j = 0; j < maxlengthgroupgrowth; j++)
-      part3 *= (alpha + beta + double(j));
 
-    tmppart3 = 1.0 / part3;
-    part4[1] = alpha;
-    if (maxlengthgroupgrowth > 1)
-      for (j = 2; j <= maxlengthgroupgrowth; j++)
-        part4[j] = part4[j - 1] * (j - 1 + alpha);
+    if (growth == lastGrowth[inarea][lgroup])
+      continue;
+
+    lastGrowth[inarea][lgroup] = growth;
+    for (a = 0; a < lastGrowth.Nrow(); a++) {
+      if ((a != inarea) && (growth == lastGrowth[a][lgroup])) {
+        for (j = 0; j <= maxlengthgroupgrowth; j++)
+          dist[j][lgroup] = (*lgrowth[a])[j][lgroup];
+        break;
+      }
+    }
+
+    if (a == lastGrowth.Nrow()) {
+      //JMB store alpha for the length groups that need to be calculated
+      calcIndex[num] = lgroup;
+      alpha[num] = tmpBeta * growth / (maxlengthgroupgrowth - growth);
+      num++;
+    }
+  }
+
+  //JMB the recurrence is calculated for all these length groups together
+  for (k = 0; k < num; k++)
+    part3[k] = 1.0;
+  for (j = 0; j < maxlengthgroupgrowth; j++)
+    for (k = 0; k < num; k++)
+      part3[k] *= (alpha[k] + tmpBeta + double(j));
+  for (k = 0; k < num; k++) {
+    part3[k] = 1.0 / part3[k];
+    part4[k] = 1.0;
+  }
+
+  for (j = 0; j <= maxlengthgroupgrowth; j++) {
+    if (j == 1)
+      for (k = 0; k < num; k++)
+        part4[k] = alpha[k];
+    else if (j > 1)
+      for (k = 0; k < num; k++)
+        part4[k] *= (j - 1 + alpha[k]);
 
-    for (j = 0; j <= maxlengthgroupgrowth; j++)
-      (*lgrowth[inarea])[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[j];
+    tmp = part1[j] * part2[j];
+    for (k = 0; k < num; k++)
+      dist[j][calcIndex[k]] = tmp * part3[k] * part4[k];
   }
 }
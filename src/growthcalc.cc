@@ -4,6 +4,7 @@
 #include "keeper.h"
 #include "readfunc.h"
 #include "readword.h"
+#include "vectormath.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -44,8 +45,9 @@ void GrowthCalcA::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
       (growthPar[7] * Area->getTemperature(area, TimeInfo->getTime()) + growthPar[8]);
 
   int i;
+  vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], growthPar[1], Lgrowth.Size());
   for (i = 0; i < Lgrowth.Size(); i++) {
-    Lgrowth[i] = tempL * pow(LgrpDiv->meanLength(i), growthPar[1]) * Fphi[i];
+    Lgrowth[i] = tempL * Lgrowth[i] * Fphi[i];
     if (Lgrowth[i] < 0.0)
       Lgrowth[i] = 0.0;
 
@@ -216,6 +218,8 @@ void GrowthCalcC::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
   double tempW = TimeInfo->getTimeStepSize() * wgrowthPar[0] *
       exp(wgrowthPar[1] * Area->getTemperature(area, TimeInfo->getTime()));
 
+  //JMB Lgrowth is used to store the power of the mean lengths until it is calculated
+  vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], lgrowthPar[7] - 1.0, Lgrowth.Size());
   for (i = 0; i < Wgrowth.Size(); i++) {
     if (numGrow[i].W < verysmall || isZero(tempW)) {
       Wgrowth[i] = 0.0;
@@ -234,8 +238,7 @@ void GrowthCalcC::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
         if (fx < verysmall)
           Lgrowth[i] = 0.0;
         else
-          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] *
-            pow(LgrpDiv->meanLength(i), lgrowthPar[7] - 1.0));
+          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] * Lgrowth[i]);
       }
     }
   }
@@ -332,6 +335,8 @@ void GrowthCalcD::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
   double tempW = TimeInfo->getTimeStepSize() * wgrowthPar[2] *
       exp(wgrowthPar[4] * Area->getTemperature(area, TimeInfo->getTime()) + wgrowthPar[5]);
 
+  //JMB Lgrowth is used to store the power of the mean lengths until it is calculated
+  vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], lgrowthPar[7] - 1.0, Lgrowth.Size());
   for (i = 0; i < Wgrowth.Size(); i++) {
     if (numGrow[i].W < verysmall) {
       Wgrowth[i] = 0.0;
@@ -351,8 +356,7 @@ void GrowthCalcD::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
         if (fx < verysmall)
           Lgrowth[i] = 0.0;
         else
-          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] *
-            pow(LgrpDiv->meanLength(i), lgrowthPar[7] - 1.0));
+          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] * Lgrowth[i]);
       }
     }
   }
@@ -482,6 +486,8 @@ void GrowthCalcE::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
   double tempW = factor * TimeInfo->getTimeStepSize() * wgrowthPar[0] *
       exp(wgrowthPar[1] * Area->getTemperature(area, TimeInfo->getTime()));
 
+  //JMB Lgrowth is used to store the power of the mean lengths until it is calculated
+  vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], lgrowthPar[7] - 1.0, Lgrowth.Size());
   for (i = 0; i < Wgrowth.Size(); i++) {
     if (numGrow[i].W < verysmall || isZero(tempW)) {
       Wgrowth[i] = 0.0;
@@ -500,8 +506,7 @@ void GrowthCalcE::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
         if (fx < verysmall)
           Lgrowth[i] = 0.0;
         else
-          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] *
-            pow(LgrpDiv->meanLength(i), lgrowthPar[7] - 1.0));
+          Lgrowth[i] = fx * Wgrowth[i] / (lgrowthPar[6] * lgrowthPar[7] * Lgrowth[i]);
       }
     }
   }
@@ -651,8 +656,9 @@ void GrowthCalcG::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
         handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
     }
   } else {
+    vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], growthPar[0], Lgrowth.Size());
     for (i = 0; i < Lgrowth.Size(); i++) {
-      Lgrowth[i] = kval * pow(LgrpDiv->meanLength(i), growthPar[0]);
+      Lgrowth[i] = kval * Lgrowth[i];
       Wgrowth[i] = (*wgrowth[inarea])[t][i];
       if ((handle.getLogLevel() >= LOGWARN) && (Wgrowth[i] < 0.0))
         handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
@@ -741,6 +747,8 @@ void GrowthCalcI::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
       exp(growthPar[3] * Area->getTemperature(area, TimeInfo->getTime()));
 
   int i;
+  //JMB Lgrowth is used to store the power of the mean lengths until it is calculated
+  vpow(&Lgrowth[0], &(LgrpDiv->meanLengths())[0], growthPar[5] - 1.0, Lgrowth.Size());
   for (i = 0; i < Wgrowth.Size(); i++) {
     if (numGrow[i].W < verysmall) {
       Wgrowth[i] = 0.0;
@@ -752,8 +760,7 @@ void GrowthCalcI::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
         Wgrowth[i] = 0.0;
         Lgrowth[i] = 0.0;
       } else {
-        Lgrowth[i] = Wgrowth[i] / (growthPar[4] * growthPar[5] *
-          pow(LgrpDiv->meanLength(i), growthPar[5] - 1.0));
+        Lgrowth[i] = Wgrowth[i] / (growthPar[4] * growthPar[5] * Lgrowth[i]);
       }
     }
   }
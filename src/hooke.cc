@@ -145,24 +145,88 @@ extern Ecosystem* EcoSystem;
 /* given a point, look for a better one nearby, one coord at a time */
 double OptInfoHooke::bestNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param) {
 
-  double minf, ftmp;
-  int i;
+  double minf, fbase, ffirst, fsecond;
+  int i, k, first, second, skipped;
   DoubleVector z(point);
+  IntVector taken(point.Size(), 0);
 
   minf = prevbest;
+  skipped = 0;
   for (i = 0; i < point.Size(); i++) {
-    z[param[i]] = point[param[i]] + delta[param[i]];
-    ftmp = EcoSystem->SimulateAndUpdate(z);
-    if (ftmp < minf) {
-      minf = ftmp;
+    k = param[i];
+    fbase = minf;
+    ffirst = minf;
+    //JMB take the step that the surrogate model expects to be better first
+    if ((surrogate) && (fitted[k] > 0) && ((slope[k] * delta[k]) > 0.0))
+      delta[k] = 0.0 - delta[k];
+    first = this->takeStep(k, delta[k]);
+    if (first) {
+      z[k] = point[k] + delta[k];
+      ffirst = EcoSystem->SimulateAndUpdate(z);
+      taken[k] += 1;
+    } else
+      skipped++;
+
+    if (ffirst < minf) {
+      this->updateSurrogate(k, delta[k], fbase, ffirst);
+      minf = ffirst;
     } else {
-      delta[param[i]] = 0.0 - delta[param[i]];
-      z[param[i]] = point[param[i]] + delta[param[i]];
-      ftmp = EcoSystem->SimulateAndUpdate(z);
-      if (ftmp < minf)
-        minf = ftmp;
+      delta[k] = 0.0 - delta[k];
+      fsecond = minf;
+      second = this->takeStep(k, delta[k]);
+      if (second) {
+        z[k] = point[k] + delta[k];
+        fsecond = EcoSystem->SimulateAndUpdate(z);
+        taken[k] += 2;
+      } else
+        skipped++;
+
+      if (first && second)
+        this->updateSurrogate(k, delta[k], fbase, fsecond, ffirst);
+      else if (first)
+        this->updateSurrogate(k, 0.0 - delta[k], fbase, ffirst);
+      else if (second)
+        this->updateSurrogate(k, delta[k], fbase, fsecond);
+
+      if (fsecond < minf)
+        minf = fsecond;
       else
-        z[param[i]] = point[param[i]];
+        z[k] = point[k];
+    }
+  }
+
+  //JMB if steps were skipped and no better point was found then take the
+  //skipped steps, so that the step length is only reduced when none of the
+  //steps improves the point, as it would be without the surrogate model
+  if ((skipped > 0) && !(minf < prevbest)) {
+    for (i = 0; i < point.Size(); i++) {
+      k = param[i];
+      fbase = minf;
+      ffirst = minf;
+      delta[k] = 0.0 - delta[k];
+      //JMB the steps already taken only need to be taken again if the point has changed
+      if ((minf < prevbest) || !(taken[k] & 1)) {
+        z[k] = point[k] + delta[k];
+        ffirst = EcoSystem->SimulateAndUpdate(z);
+        this->updateSurrogate(k, delta[k], fbase, ffirst);
+      }
+
+      if (ffirst < minf)
+        minf = ffirst;
+      else {
+        delta[k] = 0.0 - delta[k];
+        fsecond = minf;
+        if ((minf < prevbest) || !(taken[k] & 2)) {
+          z[k] = point[k] + delta[k];
+          fsecond = EcoSystem->SimulateAndUpdate(z);
+          this->updateSurrogate(k, delta[k], fbase, fsecond);
+        }
+
+        if (fsecond < minf)
+          minf = fsecond;
+        else
+          z[k] = point[k];
+      }
     }
   }
 
@@ -171,6 +235,45 @@ double OptInfoHooke::bestNearby(DoubleVector& delta, DoubleVector& point, double
   return minf;
 }
 
+/* check if the surrogate model expects a step to improve the point */
+int OptInfoHooke::takeStep(int k, double step) {
+  double change;
+
+  //JMB only skip steps when both the slope and the curvature have been estimated
+  if ((!surrogate) || (fitted[k] != 2))
+    return 1;
+
+  change = (slope[k] * step) + (0.5 * curve[k] * step * step);
+  if (change < 0.0)
+    return 1;
+
+  //JMB take some of the other steps anyway to check the surrogate model
+  return (randomNumber() < verify);
+}
+
+/* update the surrogate model from the step taken for one parameter */
+void OptInfoHooke::updateSurrogate(int k, double step, double fbase, double fstep) {
+  if ((fstep != fstep) || (isZero(step))) //check for NaN
+    return;
+
+  if (fitted[k] == 2)
+    slope[k] = ((fstep - fbase) / step) - (0.5 * curve[k] * step);
+  else {
+    slope[k] = (fstep - fbase) / step;
+    fitted[k] = 1;
+  }
+}
+
+/* update the surrogate model from the steps taken in both directions for one parameter */
+void OptInfoHooke::updateSurrogate(int k, double step, double fbase, double fplus, double fminus) {
+  if ((fplus != fplus) || (fminus != fminus) || (isZero(step))) //check for NaN
+    return;
+
+  slope[k] = (fplus - fminus) / (2.0 * step);
+  curve[k] = (fplus - (2.0 * fbase) + fminus) / (step * step);
+  fitted[k] = 2;
+}
+
 void OptInfoHooke::OptimiseLikelihood() {
 
   double oldf, newf, bestf, steplength, tmp;
@@ -192,44 +295,104 @@ void OptInfoHooke::OptimiseLikelihood() {
   IntVector rbounds(nvars, 0);
   IntVector trapped(nvars, 0);
 
-  EcoSystem->scaleVariables();
-  EcoSystem->getOptScaledValues(x);
-  EcoSystem->getOptLowerBounds(lowerb);
-  EcoSystem->getOptUpperBounds(upperb);
-  EcoSystem->getOptInitialValues(init);
-
-  for (i = 0; i < nvars; i++) {
-    // Scaling the bounds, because the parameters are scaled
-    lowerb[i] = lowerb[i] / init[i];
-    upperb[i] = upperb[i] / init[i];
-    if (lowerb[i] > upperb[i]) {
-      tmp = lowerb[i];
-      lowerb[i] = upperb[i];
-      upperb[i] = tmp;
+  //JMB the surrogate model is estimated from the steps taken during the search
+  slope.Reset();
+  slope.resize(nvars, 0.0);
+  curve.Reset();
+  curve.resize(nvars, 0.0);
+  fitted.Reset();
+  fitted.resize(nvars, 0);
+  if (surrogate)
+    handle.logMessage(LOGINFO, "Using a surrogate model to skip the steps that are not expected to improve the point");
+
+  if (EcoSystem->isResuming()) {
+    //JMB continue the optimisation from the state that has been saved
+    Checkpoint* check = EcoSystem->getCheckpoint();
+    check->read(x);
+    check->read(bestx);
+    check->read(lowerb);
+    check->read(upperb);
+    check->read(init);
+    check->read(initialstep);
+    check->read(delta);
+    check->read(param);
+    check->read(lbound);
+    check->read(rbounds);
+    check->read(trapped);
+    check->read(slope);
+    check->read(curve);
+    check->read(fitted);
+    check->read(bestf);
+    check->read(newf);
+    check->read(oldf);
+    check->read(steplength);
+    check->read(offset);
+    check->closeRead(EcoSystem->getFuncEval());
+
+  } else {
+    EcoSystem->scaleVariables();
+    EcoSystem->getOptScaledValues(x);
+    EcoSystem->getOptLowerBounds(lowerb);
+    EcoSystem->getOptUpperBounds(upperb);
+    EcoSystem->getOptInitialValues(init);
+
+    for (i = 0; i < nvars; i++) {
+      // Scaling the bounds, because the parameters are scaled
+      lowerb[i] = lowerb[i] / init[i];
+      upperb[i] = upperb[i] / init[i];
+      if (lowerb[i] > upperb[i]) {
+        tmp = lowerb[i];
+        lowerb[i] = upperb[i];
+        upperb[i] = tmp;
+      }
+
+      bestx[i] = x[i];
+      trialx[i] = x[i];
+      param[i] = i;
+      delta[i] = ((2 * (rand() % 2)) - 1) * rho;  //JMB - randomise the sign
     }
 
-    bestx[i] = x[i];
-    trialx[i] = x[i];
-    param[i] = i;
-    delta[i] = ((2 * (rand() % 2)) - 1) * rho;  //JMB - randomise the sign
-  }
+    bestf = EcoSystem->SimulateAndUpdate(trialx);
+    if (bestf != bestf) { //check for NaN
+      handle.logMessage(LOGINFO, "Error starting Hooke & Jeeves optimisation with f(x) = infinity");
+      converge = -1;
+      iters = 1;
+      return;
+    }
 
-  bestf = EcoSystem->SimulateAndUpdate(trialx);
-  if (bestf != bestf) { //check for NaN
-    handle.logMessage(LOGINFO, "Error starting Hooke & Jeeves optimisation with f(x) = infinity");
-    converge = -1;
-    iters = 1;
-    return;
+    offset = EcoSystem->getFuncEval();  //number of function evaluations done before loop
+    newf = bestf;
+    oldf = bestf;
+    steplength = lambda;
+    if (isZero(steplength))
+      steplength = rho;
   }
 
-  offset = EcoSystem->getFuncEval();  //number of function evaluations done before loop
-  newf = bestf;
-  oldf = bestf;
-  steplength = lambda;
-  if (isZero(steplength))
-    steplength = rho;
-
   while (1) {
+    if (EcoSystem->checkpointDue()) {
+      Checkpoint* check = EcoSystem->writeCheckpoint();
+      check->write(x);
+      check->write(bestx);
+      check->write(lowerb);
+      check->write(upperb);
+      check->write(init);
+      check->write(initialstep);
+      check->write(delta);
+      check->write(param);
+      check->write(lbound);
+      check->write(rbounds);
+      check->write(trapped);
+      check->write(slope);
+      check->write(curve);
+      check->write(fitted);
+      check->write(bestf);
+      check->write(newf);
+      check->write(oldf);
+      check->write(steplength);
+      check->write(offset);
+      check->closeWrite();
+    }
+
     if (isZero(bestf)) {
       iters = EcoSystem->getFuncEval() - offset;
       handle.logMessage(LOGINFO, "Error in Hooke & Jeeves optimisation after", iters, "function evaluations, f(x) = 0");
@@ -387,5 +550,7 @@ void OptInfoHooke::OptimiseLikelihood() {
     handle.logMessage(LOGINFO, "Reducing the steplength to", steplength);
     for (i = 0; i < nvars; i++)
       delta[i] *= rho;
+    //JMB the surrogate model needs to be estimated again for the new step length
+    fitted.setToZero();
   }
 }
@@ -614,6 +614,7 @@ void InitialCond::Initialise(AgeBandMatrixPtrVector& Alkeys) {
       }
 
       Alkeys[area][age].Add(initialPop[area][age], *CI, mult);
+      Alkeys[area][age].finaliseSum();
     }
   }
 
@@ -111,7 +111,51 @@ void Ecosystem::Initialise() {
   for (i = 0; i < fleetvec.Size(); i++)
     basevec.resize(fleetvec[i]);
 
-  //Next we initialise the likelihood classes
+  //Next we initialise the printer classes, since the likelihood classes need to know
+  //which likelihood components will be printed before they are initialised
+  for (i = 0; i < printvec.Size(); i++) {
+    handle.logMessage(LOGMESSAGE, "Initialising printer for output file", printvec[i]->getFileName());
+    switch (printvec[i]->getType()) {
+      case STOCKSTDPRINTER:
+        ((StockStdPrinter*)printvec[i])->setStock(stockvec, Area);
+        break;
+      case STOCKPRINTER:
+        ((StockPrinter*)printvec[i])->setStock(stockvec, Area);
+        break;
+      case PREDATORPRINTER:
+        ((PredatorPrinter*)printvec[i])->setPredAndPrey(predvec, preyvec, Area);
+        break;
+      case PREDATOROVERPRINTER:
+        ((PredatorOverPrinter*)printvec[i])->setPredator(predvec, Area);
+        break;
+      case PREYOVERPRINTER:
+        ((PreyOverPrinter*)printvec[i])->setPrey(preyvec, Area);
+        break;
+      case STOCKPREYPRINTER:
+        ((StockPreyPrinter*)printvec[i])->setPrey(preyvec, Area);
+        break;
+      case STOCKPREYFULLPRINTER:
+        ((StockPreyFullPrinter*)printvec[i])->setPrey(preyvec, Area);
+        break;
+      case PREDATORPREYPRINTER:
+        ((PredatorPreyPrinter*)printvec[i])->setPredAndPrey(predvec, preyvec, Area);
+        break;
+      case STOCKFULLPRINTER:
+        ((StockFullPrinter*)printvec[i])->setStock(stockvec, Area);
+        break;
+      case LIKELIHOODPRINTER:
+        ((LikelihoodPrinter*)printvec[i])->setLikelihood(likevec);
+        break;
+      case LIKELIHOODSUMMARYPRINTER:
+        ((SummaryPrinter*)printvec[i])->setLikelihood(likevec);
+        break;
+      default:
+        handle.logMessage(LOGFAIL, "Error when initialising model - unrecognised printer type", printvec[i]->getType());
+        break;
+    }
+  }
+
+  //Finally we initialise the likelihood classes
   count = 0;  //JMB count the number of understocking classes
   for (i = 0; i < likevec.Size(); i++) {
     handle.logMessage(LOGMESSAGE, "Initialising likelihood component", likevec[i]->getName());
@@ -165,47 +209,4 @@ void Ecosystem::Initialise() {
     handle.logMessage(LOGWARN, "Warning in input files - no understocking likelihood component found");
   if (count > 1)
     handle.logMessage(LOGWARN, "Warning in input files - repeated understocking components found");
-
-  //Finally we initialise the printer classes
-  for (i = 0; i < printvec.Size(); i++) {
-    handle.logMessage(LOGMESSAGE, "Initialising printer for output file", printvec[i]->getFileName());
-    switch (printvec[i]->getType()) {
-      case STOCKSTDPRINTER:
-        ((StockStdPrinter*)printvec[i])->setStock(stockvec, Area);
-        break;
-      case STOCKPRINTER:
-        ((StockPrinter*)printvec[i])->setStock(stockvec, Area);
-        break;
-      case PREDATORPRINTER:
-        ((PredatorPrinter*)printvec[i])->setPredAndPrey(predvec, preyvec, Area);
-        break;
-      case PREDATOROVERPRINTER:
-        ((PredatorOverPrinter*)printvec[i])->setPredator(predvec, Area);
-        break;
-      case PREYOVERPRINTER:
-        ((PreyOverPrinter*)printvec[i])->setPrey(preyvec, Area);
-        break;
-      case STOCKPREYPRINTER:
-        ((StockPreyPrinter*)printvec[i])->setPrey(preyvec, Area);
-        break;
-      case STOCKPREYFULLPRINTER:
-        ((StockPreyFullPrinter*)printvec[i])->setPrey(preyvec, Area);
-        break;
-      case PREDATORPREYPRINTER:
-        ((PredatorPreyPrinter*)printvec[i])->setPredAndPrey(predvec, preyvec, Area);
-        break;
-      case STOCKFULLPRINTER:
-        ((StockFullPrinter*)printvec[i])->setStock(stockvec, Area);
-        break;
-      case LIKELIHOODPRINTER:
-        ((LikelihoodPrinter*)printvec[i])->setLikelihood(likevec);
-        break;
-      case LIKELIHOODSUMMARYPRINTER:
-        ((SummaryPrinter*)printvec[i])->setLikelihood(likevec);
-        break;
-      default:
-        handle.logMessage(LOGFAIL, "Error when initialising model - unrecognised printer type", printvec[i]->getType());
-        break;
-    }
-  }
 }
@@ -7,21 +7,42 @@
 
 extern Ecosystem* EcoSystem;
 
+//JMB the names of the switches are not case sensitive
+static unsigned int hashName(const char* name) {
+  unsigned int hash = 2166136261U;
+  while (*name != '\0') {
+    hash ^= (unsigned int)tolower(*name);
+    hash *= 16777619U;
+    name++;
+  }
+  return hash;
+}
+
+static unsigned int hashAddress(const double* var) {
+  unsigned int hash = 2166136261U;
+  size_t addr = (size_t)var / sizeof(double);
+  while (addr != 0) {
+    hash ^= (unsigned int)(addr & 0xff);
+    hash *= 16777619U;
+    addr >>= 8;
+  }
+  return hash;
+}
+
 Keeper::Keeper() {
   stack = new StrStack();
   boundsgiven = 0;
   fileopen = 0;
   numoptvar = 0;
+  numupdates = 0;
+  freeaddress = -1;
   bestlikelihood = 0.0;
 }
 
 void Keeper::keepVariable(double& value, Parameter& attr) {
 
-  int i, index = -1;
-  for (i = 0; i < switches.Size(); i++)
-    if (switches[i] == attr)
-      index = i;
-
+  int i, index;
+  index = this->findSwitch(attr);
   if (index == -1) {
     //attr was not found -- add it to switches and values
     index = switches.Size();
@@ -38,6 +59,8 @@ void Keeper::keepVariable(double& value, Parameter& attr) {
     address[index][0] = &value;
     if (stack->getSize() != 0)
       address[index][0] = stack->sendAll();
+    this->addSwitch(index);
+    this->addAddress(index, 0);
 
   } else {
     if (value != values[index]) {
@@ -49,6 +72,7 @@ void Keeper::keepVariable(double& value, Parameter& attr) {
       address[index][i] = &value;
       if (stack->getSize() != 0)
         address[index][i] = stack->sendAll();
+      this->addAddress(index, i);
     }
   }
 }
@@ -63,46 +87,167 @@ Keeper::~Keeper() {
 }
 
 void Keeper::deleteParameter(const double& var) {
-  int i, j, check;
-  check = 0;
-  for (i = 0; i < address.Nrow(); i++) {
-    for (j = 0; j < address[i].Size(); j++) {
-      if (address[i][j] == &var) {
-        check++;
-        address[i].Delete(j);
-        if (address[i].Size() == 0) {
-          //the variable we deleted was the only one with this switch
-          address.Delete(i);
-          switches.Delete(i);
-          values.Delete(i);
-          bestvalues.Delete(i);
-          opt.Delete(i);
-          lowerbds.Delete(i);
-          upperbds.Delete(i);
-          scaledvalues.Delete(i);
-          initialvalues.Delete(i);
-          i--;
-        }
-      }
-    }
-  }
-  if (check != 1)
+  int i, j, k, entry;
+  entry = this->findAddress(&var);
+  if (entry == -1)
     handle.logMessage(LOGFAIL, "Error in keeper - failed to delete parameter");
+
+  i = addressrow[entry];
+  j = addresscol[entry];
+  this->removeAddress(entry);
+  if (address[i].Size() == 1) {
+    //the variable we deleted was the only one with this switch
+    address.Delete(i);
+    switches.Delete(i);
+    values.Delete(i);
+    bestvalues.Delete(i);
+    opt.Delete(i);
+    lowerbds.Delete(i);
+    upperbds.Delete(i);
+    scaledvalues.Delete(i);
+    initialvalues.Delete(i);
+    //JMB the switches after this one have moved so the index is calculated again
+    this->buildSwitchIndex();
+    this->buildAddressIndex();
+
+  } else {
+    //JMB the variables after this one will move down one place
+    for (k = j + 1; k < address[i].Size(); k++)
+      addresscol[this->findAddress(address[i][k].addr)]--;
+    address[i].Delete(j);
+  }
 }
 
 void Keeper::changeVariable(const double& pre, double& post) {
-  int i, j, check;
-  check = 0;
-  for (i = 0; i < address.Nrow(); i++) {
-    for (j = 0; j < address.Ncol(i); j++) {
-      if (address[i][j] == &pre) {
-        check++;
-        address[i][j] = &post;
-      }
-    }
-  }
-  if (check != 1)
+  int i, j, entry;
+  entry = this->findAddress(&pre);
+  if (entry == -1)
     handle.logMessage(LOGFAIL, "Error in keeper - failed to change variables");
+
+  i = addressrow[entry];
+  j = addresscol[entry];
+  this->removeAddress(entry);
+  address[i][j] = &post;
+  this->addAddress(i, j);
+}
+
+int Keeper::findSwitch(const Parameter& attr) const {
+  int i;
+  if (switchbuckets.Size() == 0)
+    return -1;
+
+  i = switchbuckets[hashName(attr.getName()) & (switchbuckets.Size() - 1)];
+  while (i != -1) {
+    if (switches[i] == attr)
+      return i;
+    i = switchchain[i];
+  }
+  return -1;
+}
+
+int Keeper::findAddress(const double* var) const {
+  int i;
+  if (addressbuckets.Size() == 0)
+    return -1;
+
+  i = addressbuckets[hashAddress(var) & (addressbuckets.Size() - 1)];
+  while (i != -1) {
+    if (address[addressrow[i]][addresscol[i]].addr == var)
+      return i;
+    i = addresschain[i];
+  }
+  return -1;
+}
+
+void Keeper::addSwitch(int index) {
+  unsigned int hash;
+  if (index >= switchchain.Size()) {
+    //JMB there is no space left, so the index is calculated again with more space
+    this->buildSwitchIndex();
+    return;
+  }
+
+  hash = hashName(switches[index].getName()) & (switchbuckets.Size() - 1);
+  switchchain[index] = switchbuckets[hash];
+  switchbuckets[hash] = index;
+}
+
+void Keeper::addAddress(int row, int col) {
+  int entry;
+  unsigned int hash;
+  if (freeaddress == -1) {
+    //JMB there is no space left, so the index is calculated again with more space
+    this->buildAddressIndex();
+    return;
+  }
+
+  entry = freeaddress;
+  freeaddress = addresschain[entry];
+  hash = hashAddress(address[row][col].addr) & (addressbuckets.Size() - 1);
+  addressrow[entry] = row;
+  addresscol[entry] = col;
+  addresschain[entry] = addressbuckets[hash];
+  addressbuckets[hash] = entry;
+}
+
+void Keeper::removeAddress(int entry) {
+  int i;
+  unsigned int hash;
+  hash = hashAddress(address[addressrow[entry]][addresscol[entry]].addr) & (addressbuckets.Size() - 1);
+  if (addressbuckets[hash] == entry)
+    addressbuckets[hash] = addresschain[entry];
+  else {
+    i = addressbuckets[hash];
+    while (addresschain[i] != entry)
+      i = addresschain[i];
+    addresschain[i] = addresschain[entry];
+  }
+  addresschain[entry] = freeaddress;
+  freeaddress = entry;
+}
+
+void Keeper::buildSwitchIndex() {
+  int i, numbuckets;
+  //JMB the number of buckets is a power of 2, with space for at least twice the number of switches
+  numbuckets = 16;
+  while (numbuckets < 4 * switches.Size())
+    numbuckets *= 2;
+
+  switchbuckets.Reset();
+  switchchain.Reset();
+  switchbuckets.resize(numbuckets, -1);
+  switchchain.resize(numbuckets / 2, -1);
+  for (i = 0; i < switches.Size(); i++)
+    this->addSwitch(i);
+}
+
+void Keeper::buildAddressIndex() {
+  int i, j, numbuckets, numaddress;
+  numaddress = 0;
+  for (i = 0; i < address.Nrow(); i++)
+    numaddress += address.Ncol(i);
+
+  //JMB the number of buckets is a power of 2, with space for at least twice the number of variables
+  numbuckets = 16;
+  while (numbuckets < 4 * numaddress)
+    numbuckets *= 2;
+
+  addressbuckets.Reset();
+  addresschain.Reset();
+  addressrow.Reset();
+  addresscol.Reset();
+  addressbuckets.resize(numbuckets, -1);
+  addresschain.resize(numbuckets / 2, -1);
+  addressrow.resize(numbuckets / 2, 0);
+  addresscol.resize(numbuckets / 2, 0);
+
+  //JMB the entries that are not used are kept in a list
+  for (i = 0; i < addresschain.Size() - 1; i++)
+    addresschain[i] = i + 1;
+  freeaddress = 0;
+  for (i = 0; i < address.Nrow(); i++)
+    for (j = 0; j < address.Ncol(i); j++)
+      this->addAddress(i, j);
 }
 
 void Keeper::clearLast() {
@@ -136,6 +281,12 @@ void Keeper::getCurrentValues(DoubleVector& val) const {
     val[i] = values[i];
 }
 
+void Keeper::getBestValues(DoubleVector& val) const {
+  int i;
+  for (i = 0; i < bestvalues.Size(); i++)
+    val[i] = bestvalues[i];
+}
+
 void Keeper::getInitialValues(DoubleVector& val) const {
   int i;
   for (i = 0; i < initialvalues.Size(); i++)
@@ -204,6 +355,7 @@ void Keeper::Update(const DoubleVector& val) {
   if (val.Size() != values.Size())
     handle.logMessage(LOGFAIL, "Error in keeper - received wrong number of variables to update");
 
+  numupdates++;
   for (i = 0; i < address.Nrow(); i++) {
     for (j = 0; j < address.Ncol(i); j++)
       *address[i][j].addr = val[i];
@@ -224,6 +376,7 @@ void Keeper::Update(int pos, double& value) {
   if (pos <= 0 && pos >= address.Nrow())
     handle.logMessage(LOGFAIL, "Error in keeper - received invalid variable to update");
 
+  numupdates++;
   for (i = 0; i < address.Ncol(pos); i++)
     *address[pos][i].addr = value;
 
@@ -237,6 +390,23 @@ void Keeper::Update(int pos, double& value) {
     scaledvalues[pos] = value / initialvalues[pos];
 }
 
+void Keeper::writeCheckpoint(Checkpoint* const check) const {
+  check->write(values);
+  check->write(initialvalues);
+  check->write(bestvalues);
+  check->write(bestlikelihood);
+}
+
+void Keeper::readCheckpoint(Checkpoint* const check) {
+  DoubleVector tmpvec(values.Size(), 0.0);
+  check->read(tmpvec);
+  check->read(initialvalues);
+  check->read(bestvalues);
+  check->read(bestlikelihood);
+  //JMB this will also calculate the scaled values of the parameters
+  this->Update(tmpvec);
+}
+
 void Keeper::writeBestValues() {
   int i, j = 0;
   DoubleVector tmpvec(numoptvar, 0.0);
@@ -320,33 +490,32 @@ void Keeper::Update(const StochasticData* const Stoch) {
     IntVector match(Stoch->numVariables(), 0);
     IntVector found(switches.Size(), 0);
     for (i = 0; i < Stoch->numVariables(); i++) {
-      for (j = 0; j < switches.Size(); j++) {
-        if (Stoch->getSwitch(i) == switches[j]) {
-          values[j] = Stoch->getValue(i);
-          bestvalues[j] = Stoch->getValue(i);
-
-          if (!boundsgiven) {
-            //JMB we are going to optimise all variables
-            opt[j] = 1;
-          } else {
-            lowerbds[j] = Stoch->getLowerBound(i);
-            upperbds[j] = Stoch->getUpperBound(i);
-            opt[j] = Stoch->getOptFlag(i);
-            if (opt[j])
-              numoptvar++;
-          }
-
-          if (isZero(initialvalues[j])) {
-            if (opt[j])
-              handle.logMessage(LOGWARN, "Warning in keeper - cannot scale switch with initial value zero", switches[j].getName());
-
-            scaledvalues[j] = values[j];
-          } else
-            scaledvalues[j] = values[j] / initialvalues[j];
-
-          match[i]++;
-          found[j]++;
+      j = this->findSwitch(Stoch->getSwitch(i));
+      if (j != -1) {
+        values[j] = Stoch->getValue(i);
+        bestvalues[j] = Stoch->getValue(i);
+
+        if (!Stoch->isOptGiven()) {
+          //JMB we are going to optimise all variables
+          opt[j] = 1;
+        } else {
+          lowerbds[j] = Stoch->getLowerBound(i);
+          upperbds[j] = Stoch->getUpperBound(i);
+          opt[j] = Stoch->getOptFlag(i);
+          if (opt[j])
+            numoptvar++;
         }
+
+        if (isZero(initialvalues[j])) {
+          if (opt[j])
+            handle.logMessage(LOGWARN, "Warning in keeper - cannot scale switch with initial value zero", switches[j].getName());
+
+          scaledvalues[j] = values[j];
+        } else
+          scaledvalues[j] = values[j] / initialvalues[j];
+
+        match[i]++;
+        found[j]++;
       }
     }
 
@@ -378,6 +547,7 @@ void Keeper::Update(const StochasticData* const Stoch) {
     }
   }
 
+  numupdates++;
   for (i = 0; i < address.Nrow(); i++)
     for (j = 0; j < address.Ncol(i); j++)
       *address[i][j].addr = values[i];
@@ -456,6 +626,83 @@ void Keeper::writeParams(const OptInfoPtrVector& optvec, const char* const filen
   paramfile.clear();
 }
 
+void Keeper::writeHessian(const char* const filename, const DoubleMatrix& hess,
+  const DoubleMatrix& invhess, double likvalue, int prec) {
+
+  int i, j, k, p, w;
+  ofstream outfile;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  handle.Open(filename);
+
+  p = prec;
+  if (prec == 0)
+    p = largeprecision;
+  w = p + 8;
+
+  IntVector index(numoptvar, 0);
+  k = 0;
+  for (i = 0; i < switches.Size(); i++) {
+    if (opt[i]) {
+      index[k] = i;
+      k++;
+    }
+  }
+
+  outfile << "; ";
+  RUNID.Print(outfile);
+  outfile << "; the Hessian matrix was calculated at the point with a likelihood value of "
+    << setprecision(p) << likvalue << endl;
+
+  outfile << "; Hessian matrix\nswitch";
+  for (j = 0; j < numoptvar; j++)
+    outfile << TAB << switches[index[j]].getName();
+  outfile << endl;
+  for (i = 0; i < numoptvar; i++) {
+    outfile << switches[index[i]].getName();
+    for (j = 0; j < numoptvar; j++)
+      outfile << TAB << setw(w) << setprecision(p) << hess[i][j];
+    outfile << endl;
+  }
+
+  if (invhess.Nrow() != numoptvar) {
+    outfile << "; the Hessian matrix is not positive definite and cannot be inverted\n";
+  } else {
+    outfile << "; inverse Hessian matrix\nswitch";
+    for (j = 0; j < numoptvar; j++)
+      outfile << TAB << switches[index[j]].getName();
+    outfile << endl;
+    for (i = 0; i < numoptvar; i++) {
+      outfile << switches[index[i]].getName();
+      for (j = 0; j < numoptvar; j++)
+        outfile << TAB << setw(w) << setprecision(p) << invhess[i][j];
+      outfile << endl;
+    }
+
+    //JMB the diagonal of the inverse is positive since the LU decomposition succeeded
+    outfile << "; correlation matrix\nswitch";
+    for (j = 0; j < numoptvar; j++)
+      outfile << TAB << switches[index[j]].getName();
+    outfile << endl;
+    for (i = 0; i < numoptvar; i++) {
+      outfile << switches[index[i]].getName();
+      for (j = 0; j < numoptvar; j++)
+        outfile << TAB << setw(w) << setprecision(p)
+          << invhess[i][j] / sqrt(invhess[i][i] * invhess[j][j]);
+      outfile << endl;
+    }
+
+    outfile << "; standard errors\nswitch\tvalue\t\tstderr\n";
+    for (i = 0; i < numoptvar; i++)
+      outfile << switches[index[i]].getName() << TAB << setw(w) << setprecision(p)
+        << values[index[i]] << TAB << setw(w) << setprecision(p) << sqrt(invhess[i][i]) << endl;
+  }
+
+  handle.Close();
+  outfile.close();
+  outfile.clear();
+}
+
 void Keeper::getLowerBounds(DoubleVector& lbs) const {
   int i;
   for (i = 0; i < lbs.Size(); i++)
@@ -0,0 +1,367 @@
+#include "errorhandler.h"
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublematrix.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+/* JMB this is the limited memory version of the BFGS algorithm, which only */
+/* stores the most recent changes in the point and the gradient instead of  */
+/* the full inverse Hessian matrix, so each iteration is linear in the      */
+/* number of parameters rather than quadratic                               */
+
+extern Ecosystem* EcoSystem;
+
+//JMB the gradient points are evaluated in blocks to limit the memory needed
+static const int blocksize = 64;
+
+/* calculate the gradient of a function at a given point                    */
+/* based on the forward difference gradient approximation (A5.6.3 FDGRAD)   */
+/* Numerical Methods for Unconstrained Optimization and Nonlinear Equations */
+/* by J E Dennis and Robert B Schnabel, published by SIAM, 1996             */
+void OptInfoLBFGS::gradient(DoubleVector& point, double pointvalue,
+  DoubleVector& newgrad, const DoubleVector& lower, const DoubleVector& upper) {
+
+  int i, j, num;
+  int nvars = point.Size();
+  DoubleVector tmpacc(nvars, 0.0);
+
+  for (i = 0; i < nvars; i++) {
+    //JMB the scaled parameter values should aways be positive
+    if (point[i] < 0.0)
+      handle.logMessage(LOGINFO, "Error in L-BFGS - negative parameter when calculating the gradient", point[i]);
+
+    //JMB step backwards if the difference would go above the upper bound,
+    //unless there is even less room between the point and the lower bound
+    tmpacc[i] = gradacc * max(point[i], 1.0);
+    if ((point[i] + tmpacc[i] > upper[i]) && (upper[i] - point[i] < point[i] - lower[i]))
+      tmpacc[i] = -tmpacc[i];
+
+    //JMB and then limit the step to the room available on that side
+    if (point[i] + tmpacc[i] > upper[i])
+      tmpacc[i] = upper[i] - point[i];
+    else if (point[i] + tmpacc[i] < lower[i])
+      tmpacc[i] = lower[i] - point[i];
+  }
+
+  //JMB the points are independent so they can be evaluated concurrently
+  for (j = 0; j < nvars; j += blocksize) {
+    num = min(blocksize, nvars - j);
+    DoubleVector ftmp(num, 0.0);
+    DoubleMatrix gtmp(num, nvars, 0.0);
+    for (i = 0; i < num; i++) {
+      gtmp[i] = point;
+      gtmp[i][j + i] += tmpacc[j + i];
+    }
+
+    EcoSystem->SimulateAndUpdateBatch(gtmp, ftmp);
+    for (i = 0; i < num; i++) {
+      //JMB there is no room to move a parameter that is fixed by its bounds
+      if (isZero(tmpacc[j + i]))
+        newgrad[j + i] = 0.0;
+      else
+        newgrad[j + i] = (ftmp[i] - pointvalue) / tmpacc[j + i];
+    }
+  }
+}
+
+/* the search direction is calculated using the two-loop recursion from     */
+/* Numerical Optimization by Jorge Nocedal and Stephen J Wright (2nd        */
+/* edition, algorithm 7.4) published by Springer, 2006, and is projected    */
+/* onto the bounds of the scaled parameters                                 */
+void OptInfoLBFGS::OptimiseLikelihood() {
+
+  double tmp, normgrad, searchgrad, newf, tmpf, betan, sy, yy;
+  int i, j, k, num, resetgrad, offset, armijo, numstored, latest;
+
+  handle.logMessage(LOGINFO, "\nStarting L-BFGS optimisation algorithm\n");
+  int nvars = EcoSystem->numOptVariables();
+  int numcores = EcoSystem->getNumCores();
+  DoubleVector x(nvars);
+  DoubleVector trialx(nvars);
+  DoubleVector init(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector grad(nvars, 0.0);
+  DoubleVector trialgrad(nvars, 0.0);
+  DoubleVector search(nvars, 0.0);
+  IntVector active(nvars, 0);
+  DoubleVector rho(memory, 0.0);
+  DoubleVector alpha(memory, 0.0);
+  DoubleMatrix s(memory, nvars, 0.0);
+  DoubleMatrix y(memory, nvars, 0.0);
+
+  if (EcoSystem->isResuming()) {
+    //JMB continue the optimisation from the state that has been saved
+    Checkpoint* check = EcoSystem->getCheckpoint();
+    check->read(x);
+    check->read(init);
+    check->read(lowerb);
+    check->read(upperb);
+    check->read(grad);
+    check->read(s);
+    check->read(y);
+    check->read(rho);
+    check->read(newf);
+    check->read(resetgrad);
+    check->read(offset);
+    check->read(numstored);
+    check->read(latest);
+    check->read(gradacc);
+    check->closeRead(EcoSystem->getFuncEval());
+
+  } else {
+    EcoSystem->scaleVariables();  //JMB need to scale variables
+    EcoSystem->getOptScaledValues(x);
+    EcoSystem->getOptLowerBounds(lowerb);
+    EcoSystem->getOptUpperBounds(upperb);
+    EcoSystem->getOptInitialValues(init);
+
+    for (i = 0; i < nvars; i++) {
+      // Scaling the bounds, because the parameters are scaled
+      lowerb[i] = lowerb[i] / init[i];
+      upperb[i] = upperb[i] / init[i];
+      if (lowerb[i] > upperb[i]) {
+        tmp = lowerb[i];
+        lowerb[i] = upperb[i];
+        upperb[i] = tmp;
+      }
+      trialx[i] = x[i];
+    }
+
+    newf = EcoSystem->SimulateAndUpdate(trialx);
+    if (newf != newf) { // check for NaN
+      handle.logMessage(LOGINFO, "Error starting L-BFGS optimisation with f(x) = infinity");
+      converge = -1;
+      iters = 1;
+      return;
+    }
+
+    this->gradient(trialx, newf, grad, lowerb, upperb);
+    offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+    resetgrad = 0;
+    numstored = 0;
+    latest = 0;
+  }
+
+  while (1) {
+    if (EcoSystem->checkpointDue()) {
+      Checkpoint* check = EcoSystem->writeCheckpoint();
+      check->write(x);
+      check->write(init);
+      check->write(lowerb);
+      check->write(upperb);
+      check->write(grad);
+      check->write(s);
+      check->write(y);
+      check->write(rho);
+      check->write(newf);
+      check->write(resetgrad);
+      check->write(offset);
+      check->write(numstored);
+      check->write(latest);
+      check->write(gradacc);
+      check->closeWrite();
+    }
+
+    iters = EcoSystem->getFuncEval() - offset;
+    if (isZero(newf)) {
+      handle.logMessage(LOGINFO, "Error in L-BFGS optimisation after", iters, "function evaluations, f(x) = 0");
+      converge = -1;
+      return;
+    }
+
+    // terminate the algorithm if too many function evaluations occur
+    if (iters > lbfgsiter) {
+      handle.logMessage(LOGINFO, "\nStopping L-BFGS optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+      handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+      score = EcoSystem->SimulateAndUpdate(x);
+      handle.logMessage(LOGINFO, "\nL-BFGS finished with a likelihood score of", score);
+      return;
+    }
+
+    if (resetgrad) {
+      // terminate the algorithm if the gradient accuracy required has got too small
+      if (gradacc < gradeps) {
+        handle.logMessage(LOGINFO, "\nStopping L-BFGS optimisation algorithm\n");
+        handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The optimisation stopped because the accuracy required for the gradient");
+        handle.logMessage(LOGINFO, "calculation is too small and NOT because an optimum was found for this run");
+
+        converge = 2;
+        score = EcoSystem->SimulateAndUpdate(x);
+        handle.logMessage(LOGINFO, "\nL-BFGS finished with a likelihood score of", score);
+        return;
+      }
+
+      resetgrad = 0;
+      // make the step size when calculating the gradient smaller
+      gradacc *= gradstep;
+      handle.logMessage(LOGINFO, "Warning in L-BFGS - resetting search algorithm after", iters, "function evaluations");
+
+      numstored = 0;
+      latest = 0;
+      this->gradient(x, newf, grad, lowerb, upperb);
+    }
+
+    //JMB parameters on a bound are held fixed when the gradient points outside the bounds
+    normgrad = 0.0;
+    for (i = 0; i < nvars; i++) {
+      active[i] = (((x[i] <= lowerb[i]) && (grad[i] > 0.0)) || ((x[i] >= upperb[i]) && (grad[i] < 0.0)));
+      search[i] = (active[i] ? 0.0 : -grad[i]);
+      normgrad += search[i] * search[i];
+    }
+    normgrad = sqrt(normgrad);
+
+    // terminate the algorithm if the convergence criteria has been met
+    if ((normgrad / (1.0 + newf)) < lbfgseps) {
+      handle.logMessage(LOGINFO, "\nStopping L-BFGS optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+
+      converge = 1;
+      score = EcoSystem->SimulateAndUpdate(x);
+      handle.logMessage(LOGINFO, "\nL-BFGS finished with a likelihood score of", score);
+      return;
+    }
+
+    // multiply the projected gradient by the inverse Hessian approximation
+    k = latest;
+    for (j = 0; j < numstored; j++) {
+      k = (k + memory - 1) % memory;
+      alpha[k] = 0.0;
+      for (i = 0; i < nvars; i++)
+        alpha[k] += s[k][i] * search[i];
+      alpha[k] *= rho[k];
+      for (i = 0; i < nvars; i++)
+        search[i] -= alpha[k] * y[k][i];
+    }
+
+    if (numstored > 0) {
+      //JMB scale the initial approximation by sy / yy for the most recent step
+      j = (latest + memory - 1) % memory;
+      yy = 0.0;
+      for (i = 0; i < nvars; i++)
+        yy += y[j][i] * y[j][i];
+      tmp = 1.0 / (rho[j] * yy);
+      for (i = 0; i < nvars; i++)
+        search[i] *= tmp;
+    }
+
+    for (j = 0; j < numstored; j++) {
+      tmp = 0.0;
+      for (i = 0; i < nvars; i++)
+        tmp += y[k][i] * search[i];
+      tmp *= rho[k];
+      for (i = 0; i < nvars; i++)
+        search[i] += s[k][i] * (alpha[k] - tmp);
+      k = (k + 1) % memory;
+    }
+
+    searchgrad = 0.0;
+    for (i = 0; i < nvars; i++) {
+      if (active[i])
+        search[i] = 0.0;
+      searchgrad += grad[i] * search[i];
+    }
+
+    //JMB if this isnt a descent direction then restart from the projected gradient
+    if ((searchgrad > -verysmall) && (numstored > 0)) {
+      handle.logMessage(LOGINFO, "Warning in L-BFGS - discarding stored iterations after", iters, "function evaluations");
+      numstored = 0;
+      latest = 0;
+      continue;
+    }
+
+    // do armijo calculation, with the trial points projected onto the bounds
+    armijo = 0;
+    betan = step;
+    if (numcores > 1) {
+      //JMB evaluate a ladder of step lengths concurrently, and then take
+      //the largest step length that satisfies the armijo condition
+      while ((armijo == 0) && (betan > rathersmall)) {
+        num = 0;
+        tmp = betan;
+        while ((num < numcores) && (tmp > rathersmall)) {
+          num++;
+          tmp *= beta;
+        }
+
+        DoubleVector ladderf(num, 0.0);
+        DoubleMatrix ladder(num, nvars, 0.0);
+        tmp = betan;
+        for (k = 0; k < num; k++) {
+          for (i = 0; i < nvars; i++)
+            ladder[k][i] = min(max(x[i] + (tmp * search[i]), lowerb[i]), upperb[i]);
+          tmp *= beta;
+        }
+
+        EcoSystem->SimulateAndUpdateBatch(ladder, ladderf);
+        for (k = 0; ((k < num) && (armijo == 0)); k++) {
+          searchgrad = 0.0;
+          for (i = 0; i < nvars; i++)
+            searchgrad += grad[i] * (ladder[k][i] - x[i]);
+
+          if ((newf > ladderf[k]) && ((newf - ladderf[k]) > (-sigma * searchgrad))) {
+            armijo = 1;
+            tmpf = ladderf[k];
+            trialx = ladder[k];
+          } else
+            betan *= beta;
+        }
+      }
+
+    } else {
+      while ((armijo == 0) && (betan > rathersmall)) {
+        searchgrad = 0.0;
+        for (i = 0; i < nvars; i++) {
+          trialx[i] = min(max(x[i] + (betan * search[i]), lowerb[i]), upperb[i]);
+          searchgrad += grad[i] * (trialx[i] - x[i]);
+        }
+
+        tmpf = EcoSystem->SimulateAndUpdate(trialx);
+        if ((newf > tmpf) && ((newf - tmpf) > (-sigma * searchgrad)))
+          armijo = 1;
+        else
+          betan *= beta;
+      }
+    }
+
+    if (!armijo) {
+      resetgrad = 1;
+      continue;
+    }
+
+    this->gradient(trialx, tmpf, trialgrad, lowerb, upperb);
+    sy = 0.0;
+    for (i = 0; i < nvars; i++) {
+      s[latest][i] = trialx[i] - x[i];
+      y[latest][i] = trialgrad[i] - grad[i];
+      sy += s[latest][i] * y[latest][i];
+      x[i] = trialx[i];
+      grad[i] = trialgrad[i];
+    }
+
+    //JMB only store the step if the curvature condition is met, so that
+    //the inverse Hessian approximation stays positive definite
+    if (sy > verysmall) {
+      rho[latest] = 1.0 / sy;
+      latest = (latest + 1) % memory;
+      numstored = min(numstored + 1, memory);
+    }
+
+    newf = EcoSystem->SimulateAndUpdate(x);
+    for (i = 0; i < nvars; i++)
+      trialx[i] = x[i] * init[i];
+
+    iters = EcoSystem->getFuncEval() - offset;
+    EcoSystem->storeVariables(newf, trialx);
+    handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+    handle.logMessage(LOGINFO, "The likelihood score is", newf, "at the point");
+    EcoSystem->writeBestValues();
+  }
+}
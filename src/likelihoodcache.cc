@@ -0,0 +1,190 @@
+#include "likelihoodcache.h"
+#include "likelihood.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+#include "vectormath.h"
+
+//JMB this is used to check that a file of stored points is for the same model
+static const int cacheversion = 2;
+
+static unsigned int hashBytes(unsigned int hash, const char* ptr, int size) {
+  //JMB this is the FNV-1a hash function
+  int i;
+  for (i = 0; i < size; i++) {
+    hash ^= (unsigned char)ptr[i];
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+LikelihoodCache::LikelihoodCache(int size, const ParameterVector& switches,
+  const LikelihoodPtrVector& likevec, unsigned int modelhash) : points(size, switches.Size(), 0.0),
+  values(size, likevec.Size() + 1, 0.0), hashes(size, 0), chain(size, -1) {
+
+  int i, numbuckets, flag;
+  maxsize = size;
+  numstored = 0;
+  nextpos = 0;
+  hits = 0;
+  fileopen = 0;
+
+  //JMB the number of buckets is a power of 2, at least twice the size of the cache
+  numbuckets = 1;
+  while (numbuckets < 2 * maxsize)
+    numbuckets *= 2;
+  buckets.resize(numbuckets, -1);
+
+  //JMB the scores depend on the input files and on the approximations used
+  flag = getFastMath();
+  signature = 2166136261U;
+  signature = hashBytes(signature, (const char*)&modelhash, sizeof(unsigned int));
+  signature = hashBytes(signature, (const char*)&flag, sizeof(int));
+  for (i = 0; i < switches.Size(); i++)
+    signature = hashBytes(signature, switches[i].getName(), strlen(switches[i].getName()) + 1);
+  for (i = 0; i < likevec.Size(); i++)
+    signature = hashBytes(signature, likevec[i]->getName(), strlen(likevec[i]->getName()) + 1);
+}
+
+LikelihoodCache::~LikelihoodCache() {
+  if (fileopen) {
+    outfile.close();
+    outfile.clear();
+  }
+}
+
+unsigned int LikelihoodCache::calcHash(const DoubleVector& point) const {
+  int i;
+  unsigned int hash = 2166136261U;
+  for (i = 0; i < point.Size(); i++)
+    hash = hashBytes(hash, (const char*)&point[i], sizeof(double));
+  return hash;
+}
+
+int LikelihoodCache::findPoint(const DoubleVector& point, DoubleVector& scores) {
+  int i, pos, check;
+  unsigned int hash = this->calcHash(point);
+
+  pos = buckets[hash & (buckets.Size() - 1)];
+  while (pos != -1) {
+    if ((unsigned int)hashes[pos] == hash) {
+      //JMB the point must be exactly the same, not just close
+      check = 1;
+      for (i = 0; i < point.Size(); i++)
+        if (memcmp(&point[i], &points[pos][i], sizeof(double)) != 0)
+          check = 0;
+
+      if (check) {
+        for (i = 0; i < scores.Size(); i++)
+          scores[i] = values[pos][i];
+        hits++;
+        return 1;
+      }
+    }
+    pos = chain[pos];
+  }
+  return 0;
+}
+
+void LikelihoodCache::addPoint(const DoubleVector& point, const DoubleVector& scores) {
+  int i, pos;
+  unsigned int hash;
+
+  if (maxsize == 0)
+    return;
+
+  if (numstored == maxsize) {
+    //JMB remove the oldest entry from its bucket before it is replaced
+    hash = (unsigned int)hashes[nextpos] & (buckets.Size() - 1);
+    if (buckets[hash] == nextpos)
+      buckets[hash] = chain[nextpos];
+    else {
+      pos = buckets[hash];
+      while (chain[pos] != nextpos)
+        pos = chain[pos];
+      chain[pos] = chain[nextpos];
+    }
+  } else
+    numstored++;
+
+  hash = this->calcHash(point);
+  for (i = 0; i < point.Size(); i++)
+    points[nextpos][i] = point[i];
+  for (i = 0; i < scores.Size(); i++)
+    values[nextpos][i] = scores[i];
+  hashes[nextpos] = (int)hash;
+  chain[nextpos] = buckets[hash & (buckets.Size() - 1)];
+  buckets[hash & (buckets.Size() - 1)] = nextpos;
+
+  nextpos++;
+  if (nextpos == maxsize)
+    nextpos = 0;
+}
+
+void LikelihoodCache::storePoint(const DoubleVector& point, const DoubleVector& scores) {
+  this->addPoint(point, scores);
+  if (fileopen) {
+    int i;
+    for (i = 0; i < point.Size(); i++)
+      outfile.write((const char*)&point[i], sizeof(double));
+    for (i = 0; i < scores.Size(); i++)
+      outfile.write((const char*)&scores[i], sizeof(double));
+    outfile.flush();
+  }
+}
+
+void LikelihoodCache::openFile(const char* const filename) {
+  int i, version, numvar, numlike, check;
+  unsigned int sig;
+  DoubleVector point(points.Ncol(), 0.0);
+  DoubleVector scores(values.Ncol(), 0.0);
+
+  check = 0;
+  ifstream infile;
+  infile.open(filename, ios::in | ios::binary);
+  if (!infile.fail()) {
+    handle.Open(filename);
+    handle.logMessage(LOGMESSAGE, "Reading stored likelihood scores from file", filename);
+    infile.read((char*)&version, sizeof(int));
+    infile.read((char*)&sig, sizeof(unsigned int));
+    infile.read((char*)&numvar, sizeof(int));
+    infile.read((char*)&numlike, sizeof(int));
+    if ((!infile.fail()) && (version == cacheversion) && (sig == signature)
+        && (numvar == point.Size()) && (numlike == scores.Size())) {
+
+      check = 1;
+      while (!infile.eof()) {
+        for (i = 0; i < point.Size(); i++)
+          infile.read((char*)&point[i], sizeof(double));
+        for (i = 0; i < scores.Size(); i++)
+          infile.read((char*)&scores[i], sizeof(double));
+        if (infile.fail())
+          break;
+        this->addPoint(point, scores);
+      }
+      handle.logMessage(LOGINFO, "Read stored likelihood scores for", numstored, "points from file");
+
+    } else
+      handle.logMessage(LOGWARN, "Warning in likelihoodcache - file does not match current model, ignoring", filename);
+    handle.Close();
+  }
+  infile.close();
+  infile.clear();
+
+  if (check) {
+    //JMB the file is valid, so new points are added to the end of it
+    outfile.open(filename, ios::out | ios::app | ios::binary);
+  } else {
+    outfile.open(filename, ios::out | ios::trunc | ios::binary);
+    version = cacheversion;
+    numvar = point.Size();
+    numlike = scores.Size();
+    outfile.write((const char*)&version, sizeof(int));
+    outfile.write((const char*)&signature, sizeof(unsigned int));
+    outfile.write((const char*)&numvar, sizeof(int));
+    outfile.write((const char*)&numlike, sizeof(int));
+    outfile.flush();
+  }
+  handle.checkIfFailure(outfile, filename);
+  fileopen = 1;
+}
@@ -2,6 +2,12 @@
 #include "errorhandler.h"
 #include "global.h"
 LUDecomposition::LUDecomposition(const DoubleMatrix& A) {
+  size = 0;
+  this->Decompose(A);
+}
+
+// calculates the LU decomposition, reusing the memory from any previous decomposition of the same size
+void LUDecomposition::Decompose(const DoubleMatrix& A) {
   if (A.Ncol() != A.Nrow())
     handle.logMessage(LOGFAIL, "Error in ludecomposition - matrix not rectangular");
 
@@ -9,9 +15,14 @@ LUDecomposition::LUDecomposition(const DoubleMatrix& A) {
   int i, k, j;
   double s, tmp;
 
-  size = A.Nrow();
-  L = DoubleMatrix(size, size, 0.0);
-  U = DoubleMatrix(A);
+  if (size != A.Nrow()) {
+    size = A.Nrow();
+    L = DoubleMatrix(size, size, 0.0);
+    y.Reset();
+    y.resize(size, 0.0);
+  } else
+    L.setToZero();
+  U = A;
   logdet = 0.0;
   tmp = 0.0;
 
@@ -48,13 +59,20 @@ LUDecomposition::LUDecomposition(const DoubleMatrix& A) {
 
 // calculates the solution of Ax=b using the LU decomposition calculated in the constructor
 DoubleVector LUDecomposition::Solve(const DoubleVector& b) {
-  if (size != b.Size())
+  DoubleVector x(size, 0.0);
+  this->Solve(b, x);
+  return x;
+}
+
+// as above, but storing the solution in x to avoid allocating memory
+void LUDecomposition::Solve(const DoubleVector& b, DoubleVector& x) {
+  if ((size != b.Size()) || (size != x.Size()))
     handle.logMessage(LOGFAIL, "Error in ludecomposition - sizes not the same");
 
   int i, j;
   double s;
-  DoubleVector y(b);
-  DoubleVector x(size, 0.0);
+  for (i = 0; i < size; i++)
+    y[i] = b[i];
 
   for (i = 0; i < size; i++) {
     s = 0.0;
@@ -75,5 +93,4 @@ DoubleVector LUDecomposition::Solve(const DoubleVector& b) {
     } else
       x[i] /= U[i][i];
   }
-  return x;
 }
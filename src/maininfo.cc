@@ -2,6 +2,8 @@
 #include "errorhandler.h"
 #include "gadget.h"
 #include "runid.h"
+#include "statusblock.h"
+#include "vectormath.h"
 #include "global.h"
 
 void MainInfo::showCorrectUsage(char* error) {
@@ -18,6 +20,11 @@ void MainInfo::showUsage() {
     << " -l                           perform a likelihood (optimising) model run\n"
     << " -s                           perform a single (simulation) model run\n"
     << " -n                           perform a network run (using paramin)\n"
+    << " -server <filename>           evaluate the model for other programs through\n"
+    << "                              the local socket <filename>\n"
+    << " -hessian                     calculate the Hessian matrix at the final point\n"
+    << " -fastmath                    use faster approximations to exp, log, pow and lgamma\n"
+    << " -nosubsteps                  optimise the model without substeps before the full model\n"
     << " -v --version                 display version information and exit\n"
     << " -h --help                    display this help screen and exit\n"
     << "\nOptions for specifying the input to Gadget models:\n"
@@ -32,6 +39,21 @@ void MainInfo::showUsage() {
     << " -o <filename>                print likelihood output to <filename>\n"
     << " -print <number>              print -o output every <number> iterations\n"
     << " -precision <number>          set the precision to <number> in output files\n"
+    << "\nOptions for running Gadget on more than one processor:\n"
+    << " -cores <number>              evaluate batches of points on <number> processes\n"
+    << "\nOptions for simulating projection scenarios:\n"
+    << " -projection <filename>       read the parameters for each scenario from <filename>\n"
+    << " -projectionyear <number>     start the scenarios from the start of year <number>\n"
+    << "\nOptions for storing likelihood scores during optimising runs:\n"
+    << " -cache <number>              store the scores for the last <number> points\n"
+    << " -cachefile <filename>        also store the scores in <filename> to be reused\n"
+    << "\nOptions for restarting optimising runs:\n"
+    << " -checkpoint <filename>       save the state of the optimisation to <filename>\n"
+    << " -checkpointiter <number>     save the state every <number> function evaluations\n"
+    << " -resume <filename>           continue the optimisation saved in <filename>\n"
+    << "\nOptions for checking the progress of optimising runs:\n"
+    << " -status <filename>           write the progress of the optimisation to <filename>\n"
+    << " -watch <filename>            display the progress written to <filename> and exit\n"
     << "\nOptions for debugging Gadget models:\n"
     << " -log <filename>              print logging information to <filename>\n"
     << " -printinitial <filename>     print initial model information to <filename>\n"
@@ -42,8 +64,8 @@ void MainInfo::showUsage() {
 
 MainInfo::MainInfo()
   : givenOptInfo(0), givenInitialParam(0), runoptimise(0),
-    runstochastic(0), runnetwork(0), runprint(1), forceprint(0),
-    printInitialInfo(0), printFinalInfo(0), printLogLevel(0), maxratio(0.95) {
+    runstochastic(0), runnetwork(0), runprint(1), runhessian(0), runnosubsteps(0), forceprint(0),
+    printInitialInfo(0), printFinalInfo(0), printLogLevel(0), numcores(1), cachesize(0), checkpointiter(0), projectionyear(0), maxratio(0.95) {
 
   char tmpname[10];
   strncpy(tmpname, "", 10);
@@ -54,6 +76,12 @@ MainInfo::MainInfo()
   strPrintInitialFile = NULL;
   strPrintFinalFile = NULL;
   strMainGadgetFile = NULL;
+  strCacheFile = NULL;
+  strCheckpointFile = NULL;
+  strResumeFile = NULL;
+  strStatusFile = NULL;
+  strServerFile = NULL;
+  strProjectionFile = NULL;
   setMainGadgetFile(tmpname);
 }
 
@@ -78,6 +106,30 @@ MainInfo::~MainInfo() {
     delete[] strMainGadgetFile;
     strMainGadgetFile = NULL;
   }
+  if (strCacheFile != NULL) {
+    delete[] strCacheFile;
+    strCacheFile = NULL;
+  }
+  if (strCheckpointFile != NULL) {
+    delete[] strCheckpointFile;
+    strCheckpointFile = NULL;
+  }
+  if (strResumeFile != NULL) {
+    delete[] strResumeFile;
+    strResumeFile = NULL;
+  }
+  if (strStatusFile != NULL) {
+    delete[] strStatusFile;
+    strStatusFile = NULL;
+  }
+  if (strServerFile != NULL) {
+    delete[] strServerFile;
+    strServerFile = NULL;
+  }
+  if (strProjectionFile != NULL) {
+    delete[] strProjectionFile;
+    strProjectionFile = NULL;
+  }
 }
 
 void MainInfo::read(int aNumber, char* const aVector[]) {
@@ -102,6 +154,83 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
     } else if (strcasecmp(aVector[k], "-s") == 0) {
       runstochastic = 1;
 
+    } else if (strcasecmp(aVector[k], "-server") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setServerFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-hessian") == 0) {
+      runhessian = 1;
+
+    } else if (strcasecmp(aVector[k], "-nosubsteps") == 0) {
+      runnosubsteps = 1;
+
+    } else if (strcasecmp(aVector[k], "-fastmath") == 0) {
+      //JMB use the vectorised approximations instead of the standard library functions
+      setFastMath(1);
+
+    } else if (strcasecmp(aVector[k], "-cores") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      numcores = atoi(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-projection") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setProjectionFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-projectionyear") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      projectionyear = atoi(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-cache") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      cachesize = atoi(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-cachefile") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setCacheFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-checkpoint") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setCheckpointFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-checkpointiter") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      checkpointiter = atoi(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-resume") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setResumeFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-status") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setStatusFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-watch") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      StatusBlock::Watch(aVector[k]);
+      exit(EXIT_SUCCESS);
+
     } else if (strcasecmp(aVector[k], "-m") == 0) {
       ifstream infile;
       CommentStream incomment(infile);
@@ -282,6 +411,12 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     tmpin.close();
     tmpin.clear();
   }
+  if (strProjectionFile != NULL) {
+    tmpin.open(strProjectionFile, ios::in);
+    handle.checkIfFailure(tmpin, strProjectionFile);
+    tmpin.close();
+    tmpin.clear();
+  }
   if (givenOptInfo) {
     tmpin.open(strOptInfoFile, ios::in);
     handle.checkIfFailure(tmpin, strOptInfoFile);
@@ -316,6 +451,16 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     runstochastic = 1;
   }
 
+  if ((strServerFile != NULL) && (runnetwork)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget cannot run as a server during a network run\nGadget will ignore the -server switch");
+    this->setServerFile(NULL);
+  }
+
+  if ((strServerFile != NULL) && (!runstochastic)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget running as a server should be used with -s option\nGadget will now set the -s switch to perform simulation runs");
+    runstochastic = 1;
+  }
+
   if ((runstochastic) && (runoptimise)) {
     handle.logMessage(LOGWARN, "\nWarning - Gadget has been started with both the -s switch and the -l switch\nHowever, it is not possible to do both a simulation run and a likelihood run!\nGadget will perform only the simulation run (and ignore the -l switch)");
     runoptimise = 0;
@@ -326,6 +471,85 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     runstochastic = 1;
   }
 
+  if ((runnosubsteps) && (!runoptimise)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only optimise the model without substeps during an optimising run\nGadget will ignore the -nosubsteps switch");
+    runnosubsteps = 0;
+  }
+
+  if ((runhessian) && (runnetwork)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget cannot calculate the Hessian matrix during a network run\nGadget will ignore the -hessian switch");
+    runhessian = 0;
+  }
+
+  if ((strServerFile != NULL) && ((runhessian) || (printFinalInfo))) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget cannot calculate the Hessian matrix or print final model information when running as a server\nGadget will ignore the -hessian and -printfinal switches");
+    runhessian = 0;
+    printFinalInfo = 0;
+  }
+#ifndef NOT_WINDOWS
+  if (strServerFile != NULL)
+    handle.logMessage(LOGFAIL, "Error - Gadget cannot run as a server on this platform");
+#endif
+
+  //JMB check the options used to simulate projection scenarios
+  if ((strProjectionFile != NULL) && ((!runstochastic) || (runnetwork) || (strServerFile != NULL))) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only simulate projection scenarios during a simulation run\nGadget will ignore the -projection switch");
+    this->setProjectionFile(NULL);
+  }
+  if ((strProjectionFile != NULL) && (projectionyear == 0))
+    handle.logMessage(LOGFAIL, "Error - no year given for the start of the projection scenarios");
+#ifndef NOT_WINDOWS
+  if (strProjectionFile != NULL)
+    handle.logMessage(LOGFAIL, "Error - Gadget cannot simulate projection scenarios on this platform");
+#endif
+
+  //JMB check the number of processes used to evaluate batches of points
+  if (numcores < 1) {
+    handle.logMessage(LOGWARN, "Warning - number of cores must be positive", numcores);
+    numcores = 1;
+  }
+#ifndef NOT_WINDOWS
+  if (numcores > 1) {
+    handle.logMessage(LOGWARN, "Warning - Gadget cannot use more than one core on this platform");
+    numcores = 1;
+  }
+#endif
+
+  //JMB check the number of points to store likelihood scores for
+  if (cachesize < 0) {
+    handle.logMessage(LOGWARN, "Warning - number of points to store must be positive", cachesize);
+    cachesize = 0;
+  }
+  if ((strCacheFile != NULL) && (cachesize == 0))
+    cachesize = 10000;
+
+  //JMB check the options used to save the state of an optimising run
+  if (((strCheckpointFile != NULL) || (strResumeFile != NULL)) && (!runoptimise)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only save the state of an optimising run\nGadget will ignore the -checkpoint and -resume switches");
+    this->setCheckpointFile(NULL);
+    this->setResumeFile(NULL);
+  }
+  if (checkpointiter < 0) {
+    handle.logMessage(LOGWARN, "Warning - number of function evaluations between checkpoints must be positive", checkpointiter);
+    checkpointiter = 0;
+  }
+  if ((strResumeFile != NULL) && (strCheckpointFile == NULL))
+    this->setCheckpointFile(strResumeFile);
+  if ((strCheckpointFile != NULL) && (checkpointiter == 0))
+    checkpointiter = 100;
+
+  //JMB check the option used to write the progress of an optimising run
+  if ((strStatusFile != NULL) && (!runoptimise) && (!runhessian)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only write the progress of an optimising run\nGadget will ignore the -status switch");
+    this->setStatusFile(NULL);
+  }
+#ifndef NOT_WINDOWS
+  if (strStatusFile != NULL) {
+    handle.logMessage(LOGWARN, "Warning - Gadget cannot write a status file on this platform");
+    this->setStatusFile(NULL);
+  }
+#endif
+
   handle.setRunOptimise(runoptimise);
   if ((printLogLevel == 1) && (!runoptimise))
     handle.logMessage(LOGWARN, "\n** Gadget cannot disable warnings for a simulation run **");
@@ -385,6 +609,38 @@ void MainInfo::read(CommentStream& infile) {
       this->setOptInfoFile(text);
     } else if (strcasecmp(text, "-forceprint") == 0) {
       forceprint = 1;
+    } else if (strcasecmp(text, "-hessian") == 0) {
+      runhessian = 1;
+    } else if (strcasecmp(text, "-nosubsteps") == 0) {
+      runnosubsteps = 1;
+    } else if (strcasecmp(text, "-fastmath") == 0) {
+      setFastMath(1);
+    } else if (strcasecmp(text, "-cores") == 0) {
+      infile >> numcores >> ws;
+    } else if (strcasecmp(text, "-projection") == 0) {
+      infile >> text >> ws;
+      this->setProjectionFile(text);
+    } else if (strcasecmp(text, "-projectionyear") == 0) {
+      infile >> projectionyear >> ws;
+    } else if (strcasecmp(text, "-cache") == 0) {
+      infile >> cachesize >> ws;
+    } else if (strcasecmp(text, "-cachefile") == 0) {
+      infile >> text >> ws;
+      this->setCacheFile(text);
+    } else if (strcasecmp(text, "-checkpoint") == 0) {
+      infile >> text >> ws;
+      this->setCheckpointFile(text);
+    } else if (strcasecmp(text, "-checkpointiter") == 0) {
+      infile >> checkpointiter >> ws;
+    } else if (strcasecmp(text, "-resume") == 0) {
+      infile >> text >> ws;
+      this->setResumeFile(text);
+    } else if (strcasecmp(text, "-status") == 0) {
+      infile >> text >> ws;
+      this->setStatusFile(text);
+    } else if (strcasecmp(text, "-server") == 0) {
+      infile >> text >> ws;
+      this->setServerFile(text);
     } else if (strcasecmp(text, "-noprint") == 0) {
       runprint = 0;
     } else if ((strcasecmp(text, "-print") == 0) || (strcasecmp(text, "-print1") == 0)) {
@@ -456,6 +712,70 @@ void MainInfo::setInitialParamFile(char* filename) {
   givenInitialParam = 1;
 }
 
+void MainInfo::setCheckpointFile(char* filename) {
+  if (strCheckpointFile != NULL) {
+    delete[] strCheckpointFile;
+    strCheckpointFile = NULL;
+  }
+  if (filename == NULL)
+    return;
+  strCheckpointFile = new char[strlen(filename) + 1];
+  strcpy(strCheckpointFile, filename);
+}
+
+void MainInfo::setResumeFile(char* filename) {
+  if (strResumeFile != NULL) {
+    delete[] strResumeFile;
+    strResumeFile = NULL;
+  }
+  if (filename == NULL)
+    return;
+  strResumeFile = new char[strlen(filename) + 1];
+  strcpy(strResumeFile, filename);
+}
+
+void MainInfo::setStatusFile(char* filename) {
+  if (strStatusFile != NULL) {
+    delete[] strStatusFile;
+    strStatusFile = NULL;
+  }
+  if (filename == NULL)
+    return;
+  strStatusFile = new char[strlen(filename) + 1];
+  strcpy(strStatusFile, filename);
+}
+
+void MainInfo::setServerFile(char* filename) {
+  if (strServerFile != NULL) {
+    delete[] strServerFile;
+    strServerFile = NULL;
+  }
+  if (filename == NULL)
+    return;
+  strServerFile = new char[strlen(filename) + 1];
+  strcpy(strServerFile, filename);
+}
+
+void MainInfo::setProjectionFile(char* filename) {
+  if (strProjectionFile != NULL) {
+    delete[] strProjectionFile;
+    strProjectionFile = NULL;
+  }
+  if (filename == NULL)
+    return;
+  strProjectionFile = new char[strlen(filename) + 1];
+  strcpy(strProjectionFile, filename);
+}
+
+void MainInfo::setCacheFile(char* filename) {
+  if (strCacheFile != NULL) {
+    delete[] strCacheFile;
+    strCacheFile = NULL;
+  }
+  strCacheFile = new char[strlen(filename) + 1];
+  strcpy(strCacheFile, filename);
+}
+
 void MainInfo::setOptInfoFile(char* filename) {
   if (strOptInfoFile != NULL) {
     delete[] strOptInfoFile;
@@ -100,7 +100,7 @@ void Maturity::Print(ofstream& outfile) const {
 
 void Maturity::Reset(const TimeClass* const TimeInfo) {
   //JMB check that the sum of the ratios is 1
-  if (TimeInfo->getTime() == 1) {
+  if (TimeInfo->didParametersChange()) {
     int i;
     ratioscale = 0.0;
     for (i = 0; i < matureRatio.Size(); i++ )
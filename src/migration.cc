@@ -591,7 +591,8 @@ int MigrationFunction::updateVariables(const TimeClass* const TimeInfo) {
   driftx.Update(TimeInfo);
   drifty.Update(TimeInfo);
 
-  if ((TimeInfo->didStepSizeChange()) || (diffusion.didChange(TimeInfo))
+  //JMB the migration penalty is calculated along with the migration on the first timestep
+  if ((TimeInfo->didParametersChange()) || (TimeInfo->didStepSizeChange()) || (diffusion.didChange(TimeInfo))
       || (driftx.didChange(TimeInfo)) || (drifty.didChange(TimeInfo)))
     return 1;
   return 0;
@@ -0,0 +1,316 @@
+#include "modelserver.h"
+#include "doublematrix.h"
+#include "ecosystem.h"
+#include "likelihood.h"
+#include "parametervector.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+extern Ecosystem* EcoSystem;
+
+//JMB this is the maximum number of points that can be sent in one batch
+static const int maxbatch = 10000;
+
+//JMB this is set when the server has been asked to stop
+static volatile sig_atomic_t stopserver = 0;
+
+#ifdef NOT_WINDOWS
+static void stopHandler(int signal) {
+  stopserver = 1;
+}
+#endif
+
+ModelServer::ModelServer(const char* const filename, int num, int printoutput) {
+  listenfd = -1;
+  lockfile = 0;
+  numproc = num;
+  print = printoutput;
+  socketname = new char[strlen(filename) + 1];
+  strcpy(socketname, filename);
+  values.resize(EcoSystem->numVariables(), 0.0);
+
+#ifdef NOT_WINDOWS
+  struct sockaddr_un addr;
+  struct stat info;
+  if (strlen(filename) >= sizeof(addr.sun_path))
+    handle.logMessage(LOGFAIL, "Error in modelserver - name of socket is too long", filename);
+
+  //JMB remove a socket left behind by a previous server, but not any other file
+  if (stat(filename, &info) == 0) {
+    if (!S_ISSOCK(info.st_mode))
+      handle.logMessage(LOGFAIL, "Error in modelserver - file already exists and is not a socket", filename);
+    unlink(filename);
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, filename);
+  listenfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenfd < 0)
+    handle.logMessage(LOGFAIL, "Error in modelserver - failed to create socket", filename);
+  if (bind(listenfd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+    handle.logMessage(LOGFAIL, "Error in modelserver - failed to bind socket", filename);
+  if (listen(listenfd, 16) != 0)
+    handle.logMessage(LOGFAIL, "Error in modelserver - failed to listen on socket", filename);
+
+  lockfile = tmpfile();
+  if (lockfile == 0)
+    handle.logMessage(LOGFAIL, "Error in modelserver - failed to create lock file");
+#else
+  handle.logMessage(LOGFAIL, "Error - Gadget cannot run as a server on this platform");
+#endif
+}
+
+ModelServer::~ModelServer() {
+#ifdef NOT_WINDOWS
+  if (listenfd >= 0) {
+    close(listenfd);
+    unlink(socketname);
+  }
+  if (lockfile != 0)
+    fclose(lockfile);
+#endif
+  delete[] socketname;
+}
+
+void ModelServer::Serve() {
+#ifdef NOT_WINDOWS
+  int i, status;
+  pid_t pid;
+  struct sigaction act;
+
+  //JMB no SA_RESTART here, so that wait() returns when the server is interrupted
+  sigemptyset(&act.sa_mask);
+  act.sa_handler = stopHandler;
+  act.sa_flags = 0;
+  sigaction(SIGINT, &act, 0);
+  sigaction(SIGTERM, &act, 0);
+
+  pids.resize(numproc, -1);
+  for (i = 0; i < numproc; i++)
+    this->startWorker(i);
+  handle.logMessage(LOGINFO, "\nWaiting for requests on socket", socketname);
+
+  while (!stopserver) {
+    pid = wait(&status);
+    if (pid < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    for (i = 0; i < numproc; i++) {
+      if (pids[i] == (int)pid) {
+        pids[i] = -1;
+        if (!stopserver) {
+          //JMB replace the worker with a new copy of the initialised model
+          handle.logMessage(LOGWARN, "Warning in modelserver - worker process stopped, starting a new worker process");
+          this->startWorker(i);
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < numproc; i++)
+    if (pids[i] > 0)
+      kill(pids[i], SIGTERM);
+  for (i = 0; i < numproc; i++)
+    if (pids[i] > 0)
+      waitpid(pids[i], NULL, 0);
+  handle.logMessage(LOGINFO, "\nStopped serving requests on socket", socketname);
+#endif
+}
+
+void ModelServer::startWorker(int id) {
+#ifdef NOT_WINDOWS
+  pid_t pid;
+  cout.flush();
+  cerr.flush();
+  pid = fork();
+  if (pid < 0)
+    handle.logMessage(LOGFAIL, "Error in modelserver - failed to create worker process");
+
+  if (pid == 0) {
+    //JMB this is the worker process - it is stopped by the server process
+    signal(SIGINT, SIG_IGN);
+    signal(SIGTSTP, SIG_IGN);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGPIPE, SIG_IGN);
+    this->runWorker();
+    _exit(EXIT_SUCCESS);
+  }
+  pids[id] = (int)pid;
+#endif
+}
+
+void ModelServer::runWorker() {
+#ifdef NOT_WINDOWS
+  int fd;
+  while (1) {
+    fd = accept(listenfd, NULL, NULL);
+    if (fd < 0) {
+      if ((errno == EINTR) || (errno == ECONNABORTED))
+        continue;
+      handle.logMessage(LOGWARN, "Warning in modelserver - failed to accept connection on socket", socketname);
+      return;
+    }
+    this->serveConnection(fd);
+  }
+#endif
+}
+
+void ModelServer::serveConnection(int fd) {
+#ifdef NOT_WINDOWS
+  char* request = NULL;
+  size_t len = 0;
+  FILE* infile = fdopen(fd, "r");
+  FILE* outfile = fdopen(dup(fd), "w");
+
+  if ((infile == 0) || (outfile == 0)) {
+    handle.logMessage(LOGWARN, "Warning in modelserver - failed to open connection");
+    if (infile != 0)
+      fclose(infile);
+    else
+      close(fd);
+    if (outfile != 0)
+      fclose(outfile);
+    return;
+  }
+
+  //JMB each request is on one line, and the reply has one line for each point
+  while ((getline(&request, &len, infile) > 0) && (!ferror(outfile))) {
+    this->serveRequest(request, outfile);
+    fflush(outfile);
+  }
+
+  free(request);
+  fclose(infile);
+  fclose(outfile);
+#endif
+}
+
+void ModelServer::serveRequest(char* request, FILE* outfile) {
+#ifdef NOT_WINDOWS
+  int i, k, numpoints, printoutput;
+  char* text;
+  struct flock lock;
+  LikelihoodPtrVector& likevec = EcoSystem->getModelLikelihoodVector();
+
+  text = strtok(request, " \t\r\n");
+  if (text == NULL)
+    return;  //JMB ignore blank lines
+
+  if (strcasecmp(text, "switches") == 0) {
+    ParameterVector switches(values.Size());
+    EcoSystem->getSwitches(switches);
+    for (i = 0; i < switches.Size(); i++)
+      fprintf(outfile, "%s%s", (i == 0 ? "" : " "), switches[i].getName());
+    fprintf(outfile, "\n");
+    return;
+  }
+
+  if (strcasecmp(text, "components") == 0) {
+    for (i = 0; i < likevec.Size(); i++)
+      fprintf(outfile, "%s%s", (i == 0 ? "" : " "), likevec[i]->getName());
+    fprintf(outfile, "\n");
+    return;
+  }
+
+  if (strcasecmp(text, "batch") == 0) {
+    //JMB a batch saves sending one request for each point, but the points
+    //are still simulated one after another by this worker
+    text = strtok(NULL, " \t\r\n");
+    numpoints = (text == NULL ? 0 : atoi(text));
+    if (numpoints < 1) {
+      fprintf(outfile, "error expected the number of points in the batch\n");
+      return;
+    }
+    if (numpoints > maxbatch) {
+      fprintf(outfile, "error too many points in the batch (maximum %d)\n", maxbatch);
+      return;
+    }
+
+    DoubleMatrix points(numpoints, values.Size(), 0.0);
+    DoubleMatrix scores(numpoints, likevec.Size() + 1, 0.0);
+    for (k = 0; k < numpoints; k++)
+      if (!this->readValues(points[k], outfile))
+        return;
+    if (!this->checkEnd(outfile))
+      return;
+
+    EcoSystem->SimulatePoints(points, scores);
+    for (k = 0; k < numpoints; k++)
+      this->writeScores(scores[k], outfile);
+    return;
+  }
+
+  if ((strcasecmp(text, "simulate") != 0) && (strcasecmp(text, "print") != 0)) {
+    fprintf(outfile, "error unrecognised request %s\n", text);
+    return;
+  }
+
+  printoutput = (strcasecmp(text, "print") == 0);
+  if ((printoutput) && (!print)) {
+    fprintf(outfile, "error printing model output has been disabled\n");
+    return;
+  }
+
+  if ((!this->readValues(values, outfile)) || (!this->checkEnd(outfile)))
+    return;
+
+  EcoSystem->Update(values);
+  if (printoutput) {
+    //JMB the workers share the model output files, so only one can print at a time
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    while ((fcntl(fileno(lockfile), F_SETLKW, &lock) != 0) && (errno == EINTR))
+      ;
+    EcoSystem->Simulate(1);
+    lock.l_type = F_UNLCK;
+    fcntl(fileno(lockfile), F_SETLK, &lock);
+  } else
+    EcoSystem->Simulate(0);
+
+  DoubleVector scores(likevec.Size() + 1, 0.0);
+  scores[0] = EcoSystem->getLikelihood();
+  for (i = 0; i < likevec.Size(); i++)
+    scores[i + 1] = likevec[i]->getUnweightedLikelihood();
+  this->writeScores(scores, outfile);
+#endif
+}
+
+int ModelServer::readValues(DoubleVector& vec, FILE* outfile) {
+  int i;
+  char* text;
+  char* end;
+  for (i = 0; i < vec.Size(); i++) {
+    text = strtok(NULL, " \t\r\n");
+    if (text == NULL) {
+      fprintf(outfile, "error expected %d values but received %d\n", vec.Size(), i);
+      return 0;
+    }
+    vec[i] = strtod(text, &end);
+    if (*end != '\0') {
+      fprintf(outfile, "error failed to read value %s\n", text);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int ModelServer::checkEnd(FILE* outfile) {
+  if (strtok(NULL, " \t\r\n") != NULL) {
+    fprintf(outfile, "error received more values than expected\n");
+    return 0;
+  }
+  return 1;
+}
+
+void ModelServer::writeScores(const DoubleVector& scores, FILE* outfile) {
+  int i;
+  for (i = 0; i < scores.Size(); i++)
+    fprintf(outfile, "%s%.*g", (i == 0 ? "" : " "), fullprecision, scores[i]);
+  fprintf(outfile, "\n");
+}
@@ -7,6 +7,8 @@
 ModelVariable::ModelVariable() {
   value = 0.0;
   mvtype = MVFORMULA;
+  changed = 1;
+  updatetime = -1;
 }
 
 void ModelVariable::setValue(double newValue) {
@@ -15,6 +17,8 @@ void ModelVariable::setValue(double newValue) {
 
   init.setValue(newValue);
   value = newValue;
+  changed = 1;
+  updatetime = -1;
 }
 
 void ModelVariable::read(CommentStream& infile,
@@ -83,8 +87,10 @@ void ModelVariable::read(CommentStream& infile,
 }
 
 int ModelVariable::didChange(const TimeClass* const TimeInfo) {
-  if (TimeInfo->getTime() == 1)
-    return 1;  //return true for the first timestep
+  //JMB on the first timestep check against the value from the previous simulation
+  //and if the parameters have been changed check against the previous timestep
+  if (TimeInfo->didParametersChange())
+    return ((mvtype == MVSTOCK) || (changed));
 
   switch (mvtype) {
     case MVFORMULA:
@@ -104,6 +110,7 @@ int ModelVariable::didChange(const TimeClass* const TimeInfo) {
 }
 
 void ModelVariable::Update(const TimeClass* const TimeInfo) {
+  double oldvalue = value;
   switch (mvtype) {
     case MVFORMULA:
       value = init;
@@ -123,6 +130,14 @@ void ModelVariable::Update(const TimeClass* const TimeInfo) {
       handle.logMessage(LOGWARN, "Warning in modelvariable - unrecognised type", mvtype);
       break;
   }
+
+  //JMB store whether the value has changed since the last timestep it was updated on
+  //this checks for an exact match, since any change must give the same results as before
+  if (TimeInfo->getTime() != updatetime) {
+    changed = ((updatetime == -1) || (oldvalue != value));
+    updatetime = TimeInfo->getTime();
+  } else if (oldvalue != value)
+    changed = 1;
 }
 
 void ModelVariable::Delete(Keeper* const keeper) const {
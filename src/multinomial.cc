@@ -1,5 +1,6 @@
 #include "multinomial.h"
 #include "mathfunc.h"
+#include "vectormath.h"
 #include "errorhandler.h"
 #include "gadget.h"
 #include "global.h"
@@ -13,13 +14,22 @@ double Multinomial::calcLogLikelihood(const DoubleVector& data, const DoubleVect
   if (data.Size() != dist.Size())
     handle.logMessage(LOGFAIL, "Error in multinomial - vectors not the same size");
 
+  //JMB only increase the size of the vector so that it is not resized each time
+  if (logdata.Size() < data.Size())
+    logdata.resize(data.Size() - logdata.Size(), 0.0);
+
   sumdist = sumdata = sumlog = likely = 0.0;
   for (i = 0; i < data.Size(); i++) {
     sumdist += dist[i];
     sumdata += data[i];
-    sumlog += logFactorial(data[i]);
+    logdata[i] = data[i] + 1.0;
   }
 
+  //JMB logFactorial(n) is lgamma(n + 1)
+  vlgamma(&logdata[0], &logdata[0], data.Size());
+  for (i = 0; i < data.Size(); i++)
+    sumlog += logdata[i];
+
   if (isZero(sumdist))
     return 0.0;
 
@@ -0,0 +1,84 @@
+#include "optinfo.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+OptInfoDE::OptInfoDE()
+  : OptInfo(), deiter(10000), deeps(1e-4), popsize(20), weight(0.5), crossover(0.9) {
+  type = OPTDE;
+  handle.logMessage(LOGMESSAGE, "Initialising Differential Evolution optimisation algorithm");
+}
+
+void OptInfoDE::read(CommentStream& infile, char* text) {
+  handle.logMessage(LOGMESSAGE, "Reading Differential Evolution optimisation parameters");
+
+  int count = 0;
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[lbfgs]") && strcasecmp(text, "[de]")) {
+    infile >> ws;
+    if (strcasecmp(text, "seed") == 0) {
+      int seed = 0;
+      infile >> seed >> ws;
+      handle.logMessage(LOGMESSAGE, "Initialising random number generator with", seed);
+      srand(seed);
+
+    } else if (strcasecmp(text, "popsize") == 0) {
+      infile >> popsize;
+      count++;
+
+    } else if (strcasecmp(text, "weight") == 0) {
+      infile >> weight;
+      count++;
+
+    } else if (strcasecmp(text, "crossover") == 0) {
+      infile >> crossover;
+      count++;
+
+    } else if ((strcasecmp(text, "deiter") == 0) || (strcasecmp(text, "maxiter") == 0)) {
+      infile >> deiter;
+      count++;
+
+    } else if (strcasecmp(text, "deeps") == 0) {
+      infile >> deeps;
+      count++;
+
+    } else {
+      handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
+      infile >> text;  //read and ignore the next entry
+    }
+    infile >> text;
+  }
+
+  if (count == 0)
+    handle.logMessage(LOGINFO, "Warning - no parameters specified for Differential Evolution optimisation algorithm");
+
+  //check the values specified in the optinfo file ...
+  if (popsize < 4) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of popsize outside bounds", popsize);
+    popsize = 20;
+  }
+  if ((weight < rathersmall) || (weight > 2.0)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of weight outside bounds", weight);
+    weight = 0.5;
+  }
+  if ((crossover < 0.0) || (crossover > 1.0)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of crossover outside bounds", crossover);
+    crossover = 0.9;
+  }
+  if (deeps < rathersmall) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of deeps outside bounds", deeps);
+    deeps = 1e-4;
+  }
+}
+
+void OptInfoDE::Print(ofstream& outfile, int prec) {
+  outfile << "; Differential Evolution algorithm ran for " << iters
+    << " function evaluations\n; and stopped when the likelihood value was "
+    << setprecision(prec) << score;
+  if (converge == -1)
+    outfile << "\n; because an error occured during the optimisation\n";
+  else if (converge == 1)
+    outfile << "\n; because the convergence criteria were met\n";
+  else
+    outfile << "\n; because the maximum number of function evaluations was reached\n";
+}
@@ -4,7 +4,8 @@
 #include "global.h"
 
 OptInfoHooke::OptInfoHooke()
-  : OptInfo(), hookeiter(1000), rho(0.5), lambda(0.0), hookeeps(1e-4), bndcheck(0.9999) {
+  : OptInfo(), hookeiter(1000), rho(0.5), lambda(0.0), hookeeps(1e-4), bndcheck(0.9999),
+    surrogate(0), verify(0.1) {
   type = OPTHOOKE;
   handle.logMessage(LOGMESSAGE, "Initialising Hooke & Jeeves optimisation algorithm");
 }
@@ -13,7 +14,8 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
   handle.logMessage(LOGMESSAGE, "Reading Hooke & Jeeves optimisation parameters");
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]")) {
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[lbfgs]") && strcasecmp(text, "[de]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int seed = 0;
@@ -41,6 +43,14 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
       infile >> bndcheck;
       count++;
 
+    } else if (strcasecmp(text, "surrogate") == 0) {
+      infile >> surrogate;
+      count++;
+
+    } else if (strcasecmp(text, "verify") == 0) {
+      infile >> verify;
+      count++;
+
     } else {
       handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
       infile >> text;  //read and ignore the next entry
@@ -64,6 +74,14 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
     handle.logMessage(LOGINFO, "Warning in optinfofile - value of bndcheck outside bounds", bndcheck);
     bndcheck = 0.9999;
   }
+  if ((surrogate != 0) && (surrogate != 1)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of surrogate outside bounds", surrogate);
+    surrogate = 0;
+  }
+  if ((verify < 0.0) || (verify > 1.0)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of verify outside bounds", verify);
+    verify = 0.1;
+  }
   if (hookeeps < rathersmall) {
     handle.logMessage(LOGINFO, "Warning in optinfofile - value of hookeeps outside bounds", hookeeps);
     hookeeps = 1e-4;
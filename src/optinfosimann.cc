@@ -14,7 +14,8 @@ void OptInfoSimann::read(CommentStream& infile, char* text) {
   handle.logMessage(LOGMESSAGE, "Reading Simulated Annealing optimisation parameters");
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]")) {
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[lbfgs]") && strcasecmp(text, "[de]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int seed = 0;
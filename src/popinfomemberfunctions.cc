@@ -12,7 +12,14 @@ void PopInfoVector::Sum(const PopInfoVector* const Number, const ConversionIndex
   for (i = 0; i < size; i++)
     v[i].setToZero();
   for (i = CI.minLength(); i < CI.maxLength(); i++)
-    v[CI.getPos(i)] += (*Number)[i];
+    v[CI.getPos(i)].addToSum((*Number)[i]);
+  this->finaliseSum();
+}
+
+void PopInfoVector::finaliseSum() {
+  int i;
+  for (i = 0; i < size; i++)
+    v[i].finaliseSum();
 }
 
 void PopInfoIndexVector::Add(const PopInfoIndexVector& Addition,
@@ -22,38 +29,14 @@ void PopInfoIndexVector::Add(const PopInfoIndexVector& Addition,
     return;
 
   PopInfo pop;
-  int l, minl, maxl;
-
-  if (CI.isSameDl()) {
-    int offset = CI.getOffset();
-    minl = max(this->minCol(), Addition.minCol() + offset);
-    maxl = min(this->maxCol(), Addition.maxCol() + offset);
-    for (l = minl; l < maxl; l++) {
-      pop = Addition[l - offset];
-      pop *= ratio;
-      v[l] += pop;
-    }
-
-  } else {
-    if (CI.isFiner()) {
-      minl = max(this->minCol(), CI.minPos(Addition.minCol()));
-      maxl = min(this->maxCol(), CI.maxPos(Addition.maxCol() - 1) + 1);
-      for (l = minl; l < maxl; l++) {
-        pop = Addition[CI.getPos(l)];
-        pop *= ratio;
-        v[l] += pop;
-        v[l].N /= CI.getNumPos(l);  //JMB CI.getNumPos() should never be zero
-      }
-
-    } else {
-      minl = max(CI.minPos(this->minCol()), Addition.minCol());
-      maxl = min(CI.maxPos(this->maxCol() - 1) + 1, Addition.maxCol());
-      for (l = minl; l < maxl; l++) {
-        pop = Addition[l];
-        pop *= ratio;
-        v[CI.getPos(l)] += pop;
-      }
-    }
+  int i, first, last;
+
+  //JMB the conversion map has already been calculated so no branches are needed here
+  CI.getRange(this->minCol(), this->maxCol(), Addition.minCol(), Addition.maxCol(), first, last);
+  for (i = first; i < last; i++) {
+    pop = Addition[CI.getFrom(i)];
+    pop *= (ratio * CI.getWeight(i));
+    v[CI.getTo(i) - minpos].addToSum(pop);
   }
 }
 
@@ -64,44 +47,21 @@ void PopInfoIndexVector::Add(const PopInfoIndexVector& Addition,
     return;
 
   PopInfo pop;
-  int l, minl, maxl;
-
-  if (CI.isSameDl()) {
-    int offset = CI.getOffset();
-    minl = max(this->minCol(), Addition.minCol() + offset);
-    maxl = min(this->maxCol(), Addition.maxCol() + offset);
-    if (maxl > Ratio.Size() + offset)
-      maxl = Ratio.Size() + offset;
+  int i, first, last;
 
-    for (l = minl; l < maxl; l++) {
-      pop = Addition[l - offset];
-      pop *= (ratio * Ratio[l - offset]);
-      v[l] += pop;
-    }
+  CI.getRange(this->minCol(), this->maxCol(), Addition.minCol(), Addition.maxCol(), first, last);
+  while ((first < last) && (CI.getFrom(last - 1) >= Ratio.Size()))
+    last--;
 
-  } else {
-    if (CI.isFiner()) {
-      minl = max(this->minCol(), CI.minPos(Addition.minCol()));
-      maxl = min(this->maxCol(), CI.maxPos(Addition.maxCol() - 1) + 1);
-
-      for (l = minl; l < maxl; l++) {
-        pop = Addition[CI.getPos(l)];
-        pop *= (ratio * Ratio[CI.getPos(l)]);
-        v[l] += pop;
-        v[l].N /= CI.getNumPos(l);  //JMB CI.getNumPos() should never be zero
-      }
-
-    } else {
-      minl = max(CI.minPos(this->minCol()), Addition.minCol());
-      maxl = min(CI.maxPos(this->maxCol() - 1) + 1, Addition.maxCol());
-      if (maxl > Ratio.Size())
-        maxl = Ratio.Size();
-
-      for (l = minl; l < maxl; l++) {
-        pop = Addition[l];
-        pop *= (ratio * Ratio[l]);
-        v[CI.getPos(l)] += pop;
-      }
-    }
+  for (i = first; i < last; i++) {
+    pop = Addition[CI.getFrom(i)];
+    pop *= (ratio * Ratio[CI.getFrom(i)] * CI.getWeight(i));
+    v[CI.getTo(i) - minpos].addToSum(pop);
   }
 }
+
+void PopInfoIndexVector::finaliseSum() {
+  int i;
+  for (i = 0; i < size; i++)
+    v[i].finaliseSum();
+}
@@ -3,6 +3,7 @@
 
 PopRatioVector::PopRatioVector(int sz, PopRatio initial) {
   size = (sz > 0 ? sz : 0);
+  capacity = size;
   int i;
   if (size > 0) {
     v = new PopRatio[size];
@@ -14,6 +15,7 @@ PopRatioVector::PopRatioVector(int sz, PopRatio initial) {
 
 PopRatioVector::PopRatioVector(const PopRatioVector& initial) {
   size = initial.size;
+  capacity = size;
   int i;
   if (size > 0) {
     v = new PopRatio[size];
@@ -34,12 +36,14 @@ void PopRatioVector::resize(PopRatio value) {
   int i;
   if (v == 0) {
     v = new PopRatio[1];
-  } else {
+    capacity = 1;
+  } else if (size == capacity) {
     PopRatio* vnew = new PopRatio[size + 1];
     for (i = 0; i < size; i++)
       vnew[i] = v[i];
     delete[] v;
     v = vnew;
+    capacity = size + 1;
   }
   v[size] = value;
   size++;
@@ -49,12 +53,14 @@ void PopRatioVector::resize(double* num, double rat) {
   int i;
   if (v == 0) {
     v = new PopRatio[1];
-  } else {
+    capacity = 1;
+  } else if (size == capacity) {
     PopRatio* vnew = new PopRatio[size + 1];
     for (i = 0; i < size; i++)
       vnew[i] = v[i];
     delete[] v;
     v = vnew;
+    capacity = size + 1;
   }
   PopRatio pop;
   v[size] = pop;
@@ -64,19 +70,9 @@ void PopRatioVector::resize(double* num, double rat) {
 }
 
 void PopRatioVector::Delete(int pos) {
+  //JMB the memory is kept so that it can be reused when entries are added again
   int i;
-  if (size > 1) {
-    PopRatio* vnew = new PopRatio[size - 1];
-    for (i = 0; i < pos; i++)
-      vnew[i] = v[i];
-    for (i = pos; i < size - 1; i++)
-      vnew[i] = v[i + 1];
-    delete[] v;
-    v = vnew;
-    size--;
-  } else {
-    delete[] v;
-    v = 0;
-    size = 0;
-  }
+  for (i = pos; i < size - 1; i++)
+    v[i] = v[i + 1];
+  size--;
 }
@@ -108,6 +108,12 @@ void PredatorPreyAggregator::Sum(const TimeClass* const TimeInfo) {
     }
   }
 
+  //JMB calculate the mean weights now that the populations have been summed
+  for (i = 0; i < mortality.Size(); i++) {
+    total[i].finaliseSum();
+    consume[i].finaliseSum();
+  }
+
   //Finally calculate the mortality caused by the predation
   ratio = 1.0 / TimeInfo->getTimeStepSize();
   for (i = 0; i < mortality.Size(); i++)
@@ -0,0 +1,32 @@
+#include "printer.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+void Printer::copyFile(int id) const {
+  char* newname = new char[strlen(filename) + MaxStrLength];
+  ifstream oldfile;
+  ofstream newfile;
+
+  //JMB the new file starts with a copy of the information printed so far
+  sprintf(newname, "%s.%d", filename, id);
+  oldfile.open(filename, ios::in | ios::binary);
+  newfile.open(newname, ios::out | ios::binary);
+  handle.checkIfFailure(newfile, newname);
+  if (oldfile.peek() != EOF)
+    newfile << oldfile.rdbuf();
+  oldfile.close();
+  newfile.close();
+  delete[] newname;
+}
+
+void Printer::branchFile(int id) {
+  char* newname = new char[strlen(filename) + MaxStrLength];
+  sprintf(newname, "%s.%d", filename, id);
+  outfile.close();
+  outfile.clear();
+  outfile.open(newname, ios::out | ios::app);
+  handle.checkIfFailure(outfile, newname);
+  delete[] filename;
+  filename = newname;
+}
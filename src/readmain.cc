@@ -305,8 +305,12 @@ void Ecosystem::readOptimisation(CommentStream& infile) {
       optvec.resize(new OptInfoSimann());
     else if (strcasecmp(text, "[bfgs]") == 0)
       optvec.resize(new OptInfoBFGS());
+    else if (strcasecmp(text, "[lbfgs]") == 0)
+      optvec.resize(new OptInfoLBFGS());
+    else if (strcasecmp(text, "[de]") == 0)
+      optvec.resize(new OptInfoDE());
     else
-      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], or [bfgs]", text);
+      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], [bfgs], [lbfgs] or [de]", text);
 
     if (!infile.eof()) {
       infile >> text;
@@ -326,7 +330,7 @@ void Ecosystem::readOptimisation(CommentStream& infile) {
 //
 // The main reading function
 //
-void Ecosystem::readMain(CommentStream& infile, const MainInfo& main) {
+void Ecosystem::readMain(CommentStream& infile, const MainInfo& main, int nosubsteps) {
 
   int i, j;
   char text[MaxStrLength];
@@ -343,6 +347,8 @@ void Ecosystem::readMain(CommentStream& infile, const MainInfo& main) {
   handle.checkIfFailure(subfile, filename);
   handle.Open(filename);
   TimeInfo = new TimeClass(subcomment, main.getMaxRatio());
+  if (nosubsteps)
+    TimeInfo->removeSubSteps();
   handle.Close();
   subfile.close();
   subfile.clear();
@@ -366,7 +372,7 @@ void Ecosystem::readMain(CommentStream& infile, const MainInfo& main) {
   infile >> text >> ws;
   while ((strcasecmp(text, "[stock]") != 0) && !infile.eof()) {
     //Do not try to read printfile if we dont need it
-    if (main.runPrint()) {
+    if ((main.runPrint()) && (!nosubsteps)) {
       subfile.open(text, ios::in);
       handle.checkIfFailure(subfile, text);
       handle.Open(text);
@@ -99,4 +99,8 @@ void RecAggregator::Sum() {
       }
     }
   }
+
+  //JMB calculate the mean weights now that the population has been summed
+  for (r = 0; r < total.Size(); r++)
+    total[r].finaliseSum();
 }
@@ -236,7 +236,7 @@ void Recaptures::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   for (i = 0; i < newDistribution.Nrow(); i++)
     for (j = 0; j < newDistribution.Ncol(i); j++)
-      delete newDistribution[i][j];
+      (*newDistribution[i][j]).setToZero();
   for (i = 0; i < modelDistribution.Nrow(); i++)
     for (j = 0; j < modelDistribution.Ncol(i); j++)
       (*modelDistribution[i][j]).setToZero();
@@ -196,10 +196,13 @@ void LogLinearRegression::storeVectors(const DoubleVector& modData, const Double
     return;
   }
 
-  x.Reset();
-  x.resize(modData.Size(), 0.0);
-  y.Reset();
-  y.resize(obsData.Size(), 0.0);
+  //JMB only create new vectors if the number of points has changed
+  if (x.Size() != modData.Size()) {
+    x.Reset();
+    x.resize(modData.Size(), 0.0);
+    y.Reset();
+    y.resize(obsData.Size(), 0.0);
+  }
 
   int i, l = 0;
   for (i = 0; i < x.Size(); i++, l++) {
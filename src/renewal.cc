@@ -3,6 +3,7 @@
 #include "readfunc.h"
 #include "keeper.h"
 #include "readword.h"
+#include "vectormath.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -35,6 +36,7 @@ RenewalData::RenewalData(CommentStream& infile, const IntVector& Areas,
   LgrpDiv = new LengthGroupDivision(minlength, maxlength, dl);
   if (LgrpDiv->Error())
     handle.logMessage(LOGFAIL, "Error in renewal - failed to create length group");
+  lengthDist.resize(LgrpDiv->numLengthGroups(), 0.0);
 
   infile >> text >> ws;
   if ((strcasecmp(text, "normalcondfile") == 0)) {
@@ -372,6 +374,10 @@ void RenewalData::setCI(const LengthGroupDivision* const GivenLDiv) {
   CI = new ConversionIndex(LgrpDiv, GivenLDiv);
   if (CI->Error())
     handle.logMessage(LOGFAIL, "Error in renewal - error when checking length structure");
+
+  //JMB store the parameters used to calculate each renewal population
+  calculated.resize(renewalTime.Size(), 0);
+  calcValues.AddRows(renewalTime.Size(), 4, 0.0);
 }
 
 void RenewalData::Print(ofstream& outfile) const {
@@ -397,120 +403,109 @@ void RenewalData::Print(ofstream& outfile) const {
 }
 
 void RenewalData::Reset() {
-  int i, age, l, minage;
-  double sum, mult, dnorm;
+  int i;
 
+  //JMB the renewal population is only calculated when it is added to the model
+  //but the renewal data for the first renewal timestep is needed for the output
   index = 0;
-  if (readoption == 0) {
-    for (i = 0; i < renewalTime.Size(); i++) {
-      age = renewalAge[i];
-
-      //JMB check that the length data is valid
-      if (isZero(meanLength[i]) || sdevLength[i] < 0.04) {
-        //JMB the limit has been set at 0.04 to keep the exponential calculation sane
-        handle.logMessage(LOGWARN, "Warning in renewal - invalid length data");
-
-        //JMB set the population to zero
-        for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
-          renewalDistribution[i][age][l].setToZero();
-
-      } else {
-        //JMB check that the mean length is within the length group range
-        if (meanLength[i] < LgrpDiv->minLength())
-          handle.logMessage(LOGWARN, "Warning in renewal - mean length is less than minimum length for stock", this->getName());
-        if (meanLength[i] > LgrpDiv->maxLength())
-          handle.logMessage(LOGWARN, "Warning in renewal - mean length is greater than maximum length for stock", this->getName());
-
-        sum = 0.0;
-        mult = 1.0 / sdevLength[i];
-        for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-          dnorm = (LgrpDiv->meanLength(l) - meanLength[i]) * mult;
-          renewalDistribution[i][age][l].N = exp(-(dnorm * dnorm) * 0.5);
-          sum += renewalDistribution[i][age][l].N;
-        }
+  for (i = 0; i < renewalTime.Size(); i++)
+    if (renewalTime[i] == renewalTime[index])
+      this->updateDistribution(i);
 
-        if (isZero(sum)) {
-          handle.logMessage(LOGWARN, "Warning in renewal - calculated zero recruits for stock", this->getName());
-          for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
-            renewalDistribution[i][age][l].setToZero();
-
-        } else {
-          sum = 10000.0 / sum;
-          for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-            renewalDistribution[i][age][l].N *= sum;
-            renewalDistribution[i][age][l].W = refWeight[l] * relCond[i];
-            if ((handle.getLogLevel() >= LOGWARN) && (isZero(renewalDistribution[i][age][l].W)) && (renewalDistribution[i][age][l].N > 0.0))
-              handle.logMessage(LOGWARN, "Warning in renewal - zero mean weight for stock", this->getName());
-          }
-        }
+  if (handle.getLogLevel() >= LOGMESSAGE)
+    handle.logMessage(LOGMESSAGE, "Reset renewal data for stock", this->getName());
+}
+
+void RenewalData::updateDistribution(int i) {
+  int age, l, minl, maxl, minage;
+  double sum, mult, dnorm;
+  double cond = 0.0, power = 0.0;
+
+  age = renewalAge[i];
+  if (readoption == 2) {
+    minage = renewalDistribution[i].minAge();
+    for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
+      renewalDistribution[i][age][l].N = (*renewalNumber[i])[age - minage][l];
+      if (handle.getLogLevel() >= LOGWARN) {
+        if (renewalDistribution[i][age][l].N < 0.0)
+          handle.logMessage(LOGWARN, "Warning in renewal - negative number of recruits", renewalDistribution[i][age][l].N);
+        if ((isZero(renewalDistribution[i][age][l].W)) && (renewalDistribution[i][age][l].N > 0.0))
+          handle.logMessage(LOGWARN, "Warning in renewal - zero mean weight for stock", this->getName());
       }
     }
+    return;
+  }
 
+  if (readoption == 0) {
+    cond = relCond[i];
+    power = 0.0;
   } else if (readoption == 1) {
-    for (i = 0; i < renewalTime.Size(); i++) {
-      age = renewalAge[i];
-
-      //JMB check that the length data is valid
-      if (isZero(meanLength[i]) || sdevLength[i] < 0.04) {
-        //JMB the limit has been set at 0.04 to keep the exponential calculation sane
-        handle.logMessage(LOGWARN, "Warning in renewal - invalid length data");
-
-        //JMB set the population to zero
-        for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
-          renewalDistribution[i][age][l].setToZero();
-
-      } else {
-        //JMB check that the mean length is within the length group range
-        if (meanLength[i] < LgrpDiv->minLength())
-          handle.logMessage(LOGWARN, "Warning in renewal - mean length is less than minimum length for stock", this->getName());
-        if (meanLength[i] > LgrpDiv->maxLength())
-          handle.logMessage(LOGWARN, "Warning in renewal - mean length is greater than maximum length for stock", this->getName());
-
-        sum = 0.0;
-        mult = 1.0 / sdevLength[i];
-        for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-          dnorm = (LgrpDiv->meanLength(l) - meanLength[i]) * mult;
-          renewalDistribution[i][age][l].N = exp(-(dnorm * dnorm) * 0.5);
-          sum += renewalDistribution[i][age][l].N;
-        }
+    cond = alpha[i];
+    power = beta[i];
+  } else
+    handle.logMessage(LOGFAIL, "Error in renewal - unrecognised data format");
 
-        if (isZero(sum)) {
-          handle.logMessage(LOGWARN, "Warning in renewal - calculated zero recruits for stock", this->getName());
-          for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
-            renewalDistribution[i][age][l].setToZero();
-
-        } else {
-          sum = 10000.0 / sum;
-          for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-            renewalDistribution[i][age][l].N *= sum;
-            renewalDistribution[i][age][l].W = alpha[i] * pow(LgrpDiv->meanLength(l), beta[i]);
-            if ((handle.getLogLevel() >= LOGWARN) && (isZero(renewalDistribution[i][age][l].W)) && (renewalDistribution[i][age][l].N > 0.0))
-              handle.logMessage(LOGWARN, "Warning in renewal - zero mean weight for stock", this->getName());
-          }
-        }
-      }
-    }
+  //JMB the renewal population only needs to be calculated again if the parameters have changed
+  if ((calculated[i]) && (calcValues[i][0] == meanLength[i]) && (calcValues[i][1] == sdevLength[i])
+      && (calcValues[i][2] == cond) && (calcValues[i][3] == power))
+    return;
+
+  calculated[i] = 1;
+  calcValues[i][0] = meanLength[i];
+  calcValues[i][1] = sdevLength[i];
+  calcValues[i][2] = cond;
+  calcValues[i][3] = power;
+
+  //JMB check that the length data is valid
+  if (isZero(meanLength[i]) || sdevLength[i] < 0.04) {
+    //JMB the limit has been set at 0.04 to keep the exponential calculation sane
+    handle.logMessage(LOGWARN, "Warning in renewal - invalid length data");
+
+    //JMB set the population to zero
+    for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
+      renewalDistribution[i][age][l].setToZero();
+    return;
+  }
 
-  } else if (readoption == 2) {
-    for (i = 0; i < renewalTime.Size(); i++) {
-      age = renewalAge[i];
-      minage = renewalDistribution[i].minAge();
-      for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-        renewalDistribution[i][age][l].N = (*renewalNumber[i])[age - minage][l];
-        if (handle.getLogLevel() >= LOGWARN) {
-          if (renewalDistribution[i][age][l].N < 0.0)
-            handle.logMessage(LOGWARN, "Warning in renewal - negative number of recruits", renewalDistribution[i][age][l].N);
-          if ((isZero(renewalDistribution[i][age][l].W)) && (renewalDistribution[i][age][l].N > 0.0))
-            handle.logMessage(LOGWARN, "Warning in renewal - zero mean weight for stock", this->getName());
-        }
-      }
-    }
+  //JMB check that the mean length is within the length group range
+  if (meanLength[i] < LgrpDiv->minLength())
+    handle.logMessage(LOGWARN, "Warning in renewal - mean length is less than minimum length for stock", this->getName());
+  if (meanLength[i] > LgrpDiv->maxLength())
+    handle.logMessage(LOGWARN, "Warning in renewal - mean length is greater than maximum length for stock", this->getName());
+
+  sum = 0.0;
+  mult = 1.0 / sdevLength[i];
+  minl = renewalDistribution[i].minLength(age);
+  maxl = renewalDistribution[i].maxLength(age);
+  for (l = minl; l < maxl; l++) {
+    dnorm = (LgrpDiv->meanLength(l) - meanLength[i]) * mult;
+    lengthDist[l] = -(dnorm * dnorm) * 0.5;
+  }
+  vexp(&lengthDist[minl], &lengthDist[minl], maxl - minl);
+  for (l = minl; l < maxl; l++) {
+    renewalDistribution[i][age][l].N = lengthDist[l];
+    sum += renewalDistribution[i][age][l].N;
+  }
 
-  } else
-    handle.logMessage(LOGFAIL, "Error in renewal - unrecognised data format");
+  if (isZero(sum)) {
+    handle.logMessage(LOGWARN, "Warning in renewal - calculated zero recruits for stock", this->getName());
+    for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++)
+      renewalDistribution[i][age][l].setToZero();
+    return;
+  }
 
-  if (handle.getLogLevel() >= LOGMESSAGE)
-    handle.logMessage(LOGMESSAGE, "Reset renewal data for stock", this->getName());
+  sum = 10000.0 / sum;
+  if (readoption == 1)
+    vpow(&lengthDist[minl], &(LgrpDiv->meanLengths())[minl], beta[i], maxl - minl);
+  for (l = minl; l < maxl; l++) {
+    renewalDistribution[i][age][l].N *= sum;
+    if (readoption == 0)
+      renewalDistribution[i][age][l].W = refWeight[l] * relCond[i];
+    else
+      renewalDistribution[i][age][l].W = alpha[i] * lengthDist[l];
+    if ((handle.getLogLevel() >= LOGWARN) && (isZero(renewalDistribution[i][age][l].W)) && (renewalDistribution[i][age][l].N > 0.0))
+      handle.logMessage(LOGWARN, "Warning in renewal - zero mean weight for stock", this->getName());
+  }
 }
 
 int RenewalData::isRenewalStepArea(int area, const TimeClass* const TimeInfo) {
@@ -526,6 +521,7 @@ void RenewalData::addRenewal(AgeBandMatrix& Alkeys, int area, const TimeClass* c
   for (i = 0; i < renewalTime.Size(); i++) {
     if ((renewalTime[i] == TimeInfo->getTime()) && (renewalArea[i] == area)) {
       index = i;
+      this->updateDistribution(i);
       if (readoption == 2)
         Alkeys.Add(renewalDistribution[i], *CI);
       else if (renewalMult[i] > verysmall)
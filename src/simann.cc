@@ -207,57 +207,109 @@ void OptInfoSimann::OptimiseLikelihood() {
   IntVector param(nvars, 0);
   IntVector nacp(nvars, 0);
 
-  EcoSystem->resetVariables();  //JMB need to reset variables in case they have been scaled
-  if (scale)
-    EcoSystem->scaleVariables();
-  EcoSystem->getOptScaledValues(x);
-  EcoSystem->getOptLowerBounds(lowerb);
-  EcoSystem->getOptUpperBounds(upperb);
-  EcoSystem->getOptInitialValues(init);
-
-  for (i = 0; i < nvars; i++) {
-    bestx[i] = x[i];
-    param[i] = i;
-  }
+  if (EcoSystem->isResuming()) {
+    //JMB continue the optimisation from the state that has been saved
+    Checkpoint* check = EcoSystem->getCheckpoint();
+    check->read(x);
+    check->read(bestx);
+    check->read(scalex);
+    check->read(lowerb);
+    check->read(upperb);
+    check->read(init);
+    check->read(fstar);
+    check->read(vm);
+    check->read(param);
+    check->read(nacp);
+    check->read(nacc);
+    check->read(naccmet);
+    check->read(nrej);
+    check->read(funcval);
+    check->read(fopt);
+    check->read(offset);
+    check->read(a);
+    check->read(t);
+    check->read(cs);
+    check->closeRead(EcoSystem->getFuncEval());
+    nsdiv = 1.0 / ns;
+
+  } else {
+    EcoSystem->resetVariables();  //JMB need to reset variables in case they have been scaled
+    if (scale)
+      EcoSystem->scaleVariables();
+    EcoSystem->getOptScaledValues(x);
+    EcoSystem->getOptLowerBounds(lowerb);
+    EcoSystem->getOptUpperBounds(upperb);
+    EcoSystem->getOptInitialValues(init);
 
-  if (scale) {
     for (i = 0; i < nvars; i++) {
-      scalex[i] = x[i];
-      // Scaling the bounds, because the parameters are scaled
-      lowerb[i] = lowerb[i] / init[i];
-      upperb[i] = upperb[i] / init[i];
-      if (lowerb[i] > upperb[i]) {
-        tmp = lowerb[i];
-        lowerb[i] = upperb[i];
-        upperb[i] = tmp;
+      bestx[i] = x[i];
+      param[i] = i;
+    }
+
+    if (scale) {
+      for (i = 0; i < nvars; i++) {
+        scalex[i] = x[i];
+        // Scaling the bounds, because the parameters are scaled
+        lowerb[i] = lowerb[i] / init[i];
+        upperb[i] = upperb[i] / init[i];
+        if (lowerb[i] > upperb[i]) {
+          tmp = lowerb[i];
+          lowerb[i] = upperb[i];
+          upperb[i] = tmp;
+        }
       }
     }
-  }
 
-  //funcval is the function value at x
-  funcval = EcoSystem->SimulateAndUpdate(x);
-  if (funcval != funcval) { //check for NaN
-    handle.logMessage(LOGINFO, "Error starting Simulated Annealing optimisation with f(x) = infinity");
-    converge = -1;
-    iters = 1;
-    return;
-  }
+    //funcval is the function value at x
+    funcval = EcoSystem->SimulateAndUpdate(x);
+    if (funcval != funcval) { //check for NaN
+      handle.logMessage(LOGINFO, "Error starting Simulated Annealing optimisation with f(x) = infinity");
+      converge = -1;
+      iters = 1;
+      return;
+    }
 
-  //the function is to be minimised so switch the sign of funcval (and trialf)
-  funcval = -funcval;
-  offset = EcoSystem->getFuncEval();  //number of function evaluations done before loop
-  nacc++;
-  cs /= lratio;  //JMB save processing time
-  nsdiv = 1.0 / ns;
-  fopt = funcval;
-  for (i = 0; i < tempcheck; i++)
-    fstar[i] = funcval;
+    //the function is to be minimised so switch the sign of funcval (and trialf)
+    funcval = -funcval;
+    offset = EcoSystem->getFuncEval();  //number of function evaluations done before loop
+    nacc++;
+    cs /= lratio;  //JMB save processing time
+    nsdiv = 1.0 / ns;
+    fopt = funcval;
+    for (i = 0; i < tempcheck; i++)
+      fstar[i] = funcval;
+    a = 0;
+  }
 
   //Start the main loop.  Note that it terminates if
   //(i) the algorithm succesfully optimises the function or
   //(ii) there are too many function evaluations
   while (1) {
-    for (a = 0; a < nt; a++) {
+    for (; a < nt; a++) {
+      if (EcoSystem->checkpointDue()) {
+        Checkpoint* check = EcoSystem->writeCheckpoint();
+        check->write(x);
+        check->write(bestx);
+        check->write(scalex);
+        check->write(lowerb);
+        check->write(upperb);
+        check->write(init);
+        check->write(fstar);
+        check->write(vm);
+        check->write(param);
+        check->write(nacp);
+        check->write(nacc);
+        check->write(naccmet);
+        check->write(nrej);
+        check->write(funcval);
+        check->write(fopt);
+        check->write(offset);
+        check->write(a);
+        check->write(t);
+        check->write(cs);
+        check->closeWrite();
+      }
+
       //Randomize the order of the parameters once in a while, to avoid
       //the order having an influence on which changes are accepted
       rchange = 0;
@@ -385,6 +437,7 @@ void OptInfoSimann::OptimiseLikelihood() {
           vm[i] = upperb[i] - lowerb[i];
       }
     }
+    a = 0;
 
     //Check termination criteria
     for (i = tempcheck - 1; i > 0; i--)
@@ -61,9 +61,8 @@ void Ecosystem::updateAgesOneArea(int area) {
       basevec[i]->updateAgePart3(area, TimeInfo);
 }
 
-void Ecosystem::Simulate(int print) {
-  int i, j, k;
-
+void Ecosystem::startSimulation() {
+  int j;
   handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
   for (j = 0; j < likevec.Size(); j++)
     likevec[j]->Reset(keeper);
@@ -74,66 +73,71 @@ void Ecosystem::Simulate(int print) {
     tagvec[j]->Reset();
 
   TimeInfo->Reset();
-  for (i = 0; i < TimeInfo->numTotalSteps(); i++) {
-    for (j = 0; j < basevec.Size(); j++)
-      basevec[j]->Reset(TimeInfo);
+}
 
-    // add in any new tagging experiments
-    tagvec.updateTags(TimeInfo);
+void Ecosystem::simulateTimeStep(int print) {
+  int j, k;
+  for (j = 0; j < basevec.Size(); j++)
+    basevec[j]->Reset(TimeInfo);
 
-    if (print)
-      for (j = 0; j < printvec.Size(); j++)
-        printvec[j]->Print(TimeInfo, 1);  //start of timestep, so printtime is 1
-
-    // migration between areas
-    if (Area->numAreas() > 1)    //no migration if there is only one area
-      for (j = 0; j < basevec.Size(); j++)
-        basevec[j]->Migrate(TimeInfo);
-
-    // predation can be split into substeps
-    for (k = 0; k < TimeInfo->numSubSteps(); k++) {
-      for (j = 0; j < Area->numAreas(); j++)
-        this->updatePredationOneArea(j);
-      TimeInfo->IncrementSubstep();
-    }
+  // add in any new tagging experiments
+  tagvec.updateTags(TimeInfo);
 
-    // maturation, spawning, recruits etc
+  if (print)
+    for (j = 0; j < printvec.Size(); j++)
+      printvec[j]->Print(TimeInfo, 1);  //start of timestep, so printtime is 1
+
+  // migration between areas
+  if (Area->numAreas() > 1)    //no migration if there is only one area
+    for (j = 0; j < basevec.Size(); j++)
+      basevec[j]->Migrate(TimeInfo);
+
+  // predation can be split into substeps
+  for (k = 0; k < TimeInfo->numSubSteps(); k++) {
     for (j = 0; j < Area->numAreas(); j++)
-      this->updatePopulationOneArea(j);
+      this->updatePredationOneArea(j);
+    TimeInfo->IncrementSubstep();
+  }
 
-    for (j = 0; j < likevec.Size(); j++)
-      likevec[j]->addLikelihood(TimeInfo);
+  // maturation, spawning, recruits etc
+  for (j = 0; j < Area->numAreas(); j++)
+    this->updatePopulationOneArea(j);
 
-    if (print)
-      for (j = 0; j < printvec.Size(); j++)
-        printvec[j]->Print(TimeInfo, 0);  //end of timestep, so printtime is 0
+  for (j = 0; j < likevec.Size(); j++)
+    likevec[j]->addLikelihood(TimeInfo);
 
-    for (j = 0; j < Area->numAreas(); j++)
-      this->updateAgesOneArea(j);
+  if (print)
+    for (j = 0; j < printvec.Size(); j++)
+      printvec[j]->Print(TimeInfo, 0);  //end of timestep, so printtime is 0
+
+  for (j = 0; j < Area->numAreas(); j++)
+    this->updateAgesOneArea(j);
 
 #ifdef INTERRUPT_HANDLER
-    if (interrupted) {
-      InterruptInterface ui;
-      if (!ui.menu()) {
-        handle.logMessage(LOGMESSAGE, "\n** Gadget interrupted - quitting current simulation **");
-        char interruptfile[15];
-        strncpy(interruptfile, "", 15);
-        strcpy(interruptfile, "interrupt.out");
-        this->writeParams(interruptfile, 0);
-        handle.logMessage(LOGMESSAGE, "** Gadget interrupted - quitting current simulation **");
-        exit(EXIT_SUCCESS);
-      }
-      interrupted = 0;
+  if (interrupted) {
+    InterruptInterface ui;
+    if (!ui.menu()) {
+      handle.logMessage(LOGMESSAGE, "\n** Gadget interrupted - quitting current simulation **");
+      char interruptfile[15];
+      strncpy(interruptfile, "", 15);
+      strcpy(interruptfile, "interrupt.out");
+      this->writeParams(interruptfile, 0);
+      handle.logMessage(LOGMESSAGE, "** Gadget interrupted - quitting current simulation **");
+      exit(EXIT_SUCCESS);
     }
+    interrupted = 0;
+  }
 #endif
 
-    // remove any expired tagging experiments
-    tagvec.deleteTags(TimeInfo);
+  // remove any expired tagging experiments
+  tagvec.deleteTags(TimeInfo);
 
-    // increase the time in the simulation
-    TimeInfo->IncrementTime();
-  }
+  // increase the time in the simulation
+  TimeInfo->IncrementTime();
+}
 
+void Ecosystem::finishSimulation() {
+  int j;
   // remove all the tagging experiments - they must have expired now
   tagvec.deleteAllTags();
 
@@ -148,3 +152,120 @@ void Ecosystem::Simulate(int print) {
     handle.logMessage(LOGMESSAGE, "\nThe current overall likelihood score is", likelihood);
   }
 }
+
+void Ecosystem::Simulate(int print) {
+  int i;
+#ifdef DEBUG
+  long allocations = numAllocations();
+#endif
+
+  this->startSimulation();
+  for (i = 0; i < TimeInfo->numTotalSteps(); i++)
+    this->simulateTimeStep(print);
+
+#ifdef DEBUG
+  //JMB check that no memory has been allocated after the first simulation
+  //some likelihood components finish setting up during the first simulation
+  //and printing the output is also allowed to allocate memory
+  allocations = numAllocations() - allocations;
+  if ((allocations > 0) && (funceval > 0) && (!print))
+    handle.logMessage(LOGWARN, "Warning in simulation - number of memory allocations was", (int)allocations);
+#endif
+
+  this->finishSimulation();
+}
+
+void Ecosystem::waitForScenario() {
+#ifdef NOT_WINDOWS
+  int status;
+  pid_t pid;
+  while (((pid = wait(&status)) < 0) && (errno == EINTR))
+    ;
+  if ((pid > 0) && ((!WIFEXITED(status)) || (WEXITSTATUS(status) != EXIT_SUCCESS)))
+    handle.logMessage(LOGWARN, "Warning in ecosystem - process simulating a projection scenario failed");
+#endif
+}
+
+void Ecosystem::Project(StochasticData* const data, int year, int print) {
+  int i, j, numsteps, numscenarios, running;
+#ifdef NOT_WINDOWS
+  pid_t pid;
+#endif
+
+  if ((year <= TimeInfo->getFirstYear()) || (year > TimeInfo->getLastYear()))
+    handle.logMessage(LOGFAIL, "Error in ecosystem - invalid year for the start of the projection", year);
+
+  //JMB the historical period is only simulated once, with the current values of the parameters
+  numsteps = TimeInfo->calcSteps(year, 1) - 1;
+  this->startSimulation();
+  for (i = 0; i < numsteps; i++)
+    this->simulateTimeStep(print);
+
+  numscenarios = 0;
+  running = 0;
+#ifdef NOT_WINDOWS
+  //JMB each scenario is then simulated by a separate process, on a copy of the
+  //model at the start of the projection, with at most numcores running at once
+  handle.logMessage(LOGINFO, "\nStarting projection scenarios from year", year);
+  cout.flush();
+  cerr.flush();
+  for (j = 0; j < printvec.Size(); j++)
+    printvec[j]->flushFile();
+
+  while (1) {
+    numscenarios++;
+    if (running == numcores) {
+      this->waitForScenario();
+      running--;
+    }
+
+    //JMB the files are copied before the rest of the base simulation is printed
+    if (print)
+      for (j = 0; j < printvec.Size(); j++)
+        printvec[j]->copyFile(numscenarios);
+
+    pid = fork();
+    if (pid == 0) {
+      //JMB this is the child process - the output is sent to the files for this scenario
+      signal(SIGINT, SIG_IGN);
+      signal(SIGTSTP, SIG_IGN);
+      handle.setLogLevel(1);
+      if (print)
+        for (j = 0; j < printvec.Size(); j++)
+          printvec[j]->branchFile(numscenarios);
+
+      //JMB anything calculated from the parameters needs to be recalculated
+      keeper->Update(data);
+      TimeInfo->setParametersChanged();
+      for (i = numsteps; i < TimeInfo->numTotalSteps(); i++)
+        this->simulateTimeStep(print);
+      this->finishSimulation();
+
+      for (j = 0; j < printvec.Size(); j++)
+        printvec[j]->flushFile();
+      _exit(EXIT_SUCCESS);
+    }
+
+    if (pid < 0)
+      handle.logMessage(LOGFAIL, "Error in ecosystem - failed to create process for projection scenario", numscenarios);
+    running++;
+
+    if (!data->isDataLeft())
+      break;
+    data->readNextLine();
+  }
+#else
+  handle.logMessage(LOGWARN, "Warning - Gadget cannot simulate projection scenarios on this platform");
+#endif
+
+  //JMB the simulation is then finished with the current values of the parameters
+  for (i = numsteps; i < TimeInfo->numTotalSteps(); i++)
+    this->simulateTimeStep(print);
+  this->finishSimulation();
+
+#ifdef NOT_WINDOWS
+  for (i = 0; i < running; i++)
+    this->waitForScenario();
+#endif
+  handle.logMessage(LOGINFO, "Finished simulating projection scenarios, number of scenarios was", numscenarios);
+}
@@ -398,7 +398,7 @@ void SpawnData::Reset(const TimeClass* const TimeInfo) {
   }
 
   //JMB check that the sum of the ratios is 1
-  if ((!onlyParent) && (TimeInfo->getTime() == 1)) {
+  if ((!onlyParent) && (TimeInfo->didParametersChange())) {
     ratioscale = 0.0;
     for (i = 0; i < spawnRatio.Size(); i++ )
       ratioscale += spawnRatio[i];
@@ -0,0 +1,182 @@
+#include "statusblock.h"
+#include "likelihood.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+//JMB this is used to check the layout of a status file that is read in
+static const int statusversion = 1;
+
+double StatusBlock::getTime() {
+#ifdef NOT_WINDOWS
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + 1e-6 * (double)tv.tv_usec;
+#else
+  return (double)time(NULL);
+#endif
+}
+
+StatusBlock::StatusBlock(const char* const filename, const LikelihoodPtrVector& likevec) {
+  block = 0;
+  header = 0;
+  scores = 0;
+  lasteval = 0;
+  lasttime = this->getTime();
+
+#ifdef NOT_WINDOWS
+  int i, fd;
+  int numlike = likevec.Size();
+  blocksize = sizeof(StatusHeader) + (numlike + 1) * sizeof(double) + numlike * MaxStrLength;
+
+  fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    handle.logMessage(LOGFAIL, "Error in statusblock - failed to open file", filename);
+  if (ftruncate(fd, blocksize) != 0)
+    handle.logMessage(LOGFAIL, "Error in statusblock - failed to set the size of file", filename);
+  block = (char*)mmap(NULL, blocksize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (block == (char*)MAP_FAILED)
+    handle.logMessage(LOGFAIL, "Error in statusblock - failed to map file", filename);
+
+  //JMB the file has just been created so everything else is zero
+  header = (StatusHeader*)block;
+  scores = (double*)(block + sizeof(StatusHeader));
+  header->version = statusversion;
+  header->numlike = numlike;
+  header->pid = (int)getpid();
+  header->starttime = lasttime;
+  header->updatetime = lasttime;
+  strncpy(header->phase, "starting", StatusPhaseLength - 1);
+  for (i = 0; i < numlike; i++)
+    strncpy(block + sizeof(StatusHeader) + (numlike + 1) * sizeof(double) + i * MaxStrLength,
+      likevec[i]->getName(), MaxStrLength - 1);
+  handle.logMessage(LOGMESSAGE, "Writing the status of the model run to file", filename);
+#else
+  handle.logMessage(LOGWARN, "Warning - Gadget cannot write a status file on this platform");
+#endif
+}
+
+StatusBlock::~StatusBlock() {
+  this->setPhase("finished");
+#ifdef NOT_WINDOWS
+  if (block != 0)
+    munmap(block, blocksize);
+#endif
+}
+
+void StatusBlock::Update(int funceval, const DoubleVector& vec) {
+  if (header == 0)
+    return;
+
+  int i;
+  double now = this->getTime();
+
+  header->sequence++;  //JMB this is now odd while the status is being written
+  __sync_synchronize();
+  if ((header->funceval == 0) || (vec[0] < header->bestlikelihood) || (header->bestlikelihood != header->bestlikelihood))
+    header->bestlikelihood = vec[0];
+  header->funceval = funceval;
+  header->updatetime = now;
+  header->likelihood = vec[0];
+  for (i = 0; i < vec.Size(); i++)
+    scores[i] = vec[i];
+
+  //JMB only recalculate the rate once a second to smooth out the noise
+  if (lasteval == 0) {
+    lasttime = now;
+    lasteval = funceval;
+  } else if (now - lasttime >= 1.0) {
+    header->evalrate = (funceval - lasteval) / (now - lasttime);
+    lasttime = now;
+    lasteval = funceval;
+  }
+  __sync_synchronize();
+  header->sequence++;
+}
+
+void StatusBlock::setPhase(const char* const phase) {
+  if (header == 0)
+    return;
+
+  header->sequence++;
+  __sync_synchronize();
+  strncpy(header->phase, phase, StatusPhaseLength - 1);
+  header->updatetime = this->getTime();
+  __sync_synchronize();
+  header->sequence++;
+}
+
+void StatusBlock::Watch(const char* const filename) {
+#ifdef NOT_WINDOWS
+  int i, fd, size, numlike, check, alive;
+  unsigned int seq;
+  double lastupdate = -1.0;
+  struct stat st;
+  char* mapped;
+  StatusHeader* ptr;
+
+  fd = open(filename, O_RDONLY);
+  if ((fd < 0) || (fstat(fd, &st) != 0) || (st.st_size < (int)sizeof(StatusHeader))) {
+    cerr << "Error - failed to read status file " << filename << endl;
+    exit(EXIT_FAILURE);
+  }
+  size = st.st_size;
+  mapped = (char*)mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  ptr = (StatusHeader*)mapped;
+  if ((mapped == (char*)MAP_FAILED) || (ptr->version != statusversion)) {
+    cerr << "Error - failed to read status file " << filename << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  numlike = ptr->numlike;
+  if (size < (int)(sizeof(StatusHeader) + (numlike + 1) * sizeof(double) + numlike * MaxStrLength)) {
+    cerr << "Error - failed to read status file " << filename << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  StatusHeader copy;
+  DoubleVector tmpscores(numlike + 1, 0.0);
+  const char* names = mapped + sizeof(StatusHeader) + (numlike + 1) * sizeof(double);
+
+  cout << "funceval\tevals/sec\tbest\tcurrent\tphase";
+  for (i = 0; i < numlike; i++)
+    cout << TAB << names + i * MaxStrLength;
+  cout << endl;
+
+  check = 1;
+  while (check) {
+    //JMB take a consistent copy of the status, trying again if it is being written
+    do {
+      seq = ptr->sequence;
+      __sync_synchronize();
+      memcpy(&copy, ptr, sizeof(StatusHeader));
+      for (i = 0; i <= numlike; i++)
+        tmpscores[i] = ((const double*)(mapped + sizeof(StatusHeader)))[i];
+      __sync_synchronize();
+    } while ((seq % 2 == 1) || (seq != ptr->sequence));
+
+    copy.phase[StatusPhaseLength - 1] = '\0';
+    if (copy.updatetime != lastupdate) {
+      lastupdate = copy.updatetime;
+      cout << copy.funceval << TAB << setprecision(4) << copy.evalrate << TAB
+        << setprecision(10) << copy.bestlikelihood << TAB << copy.likelihood << TAB << copy.phase;
+      for (i = 0; i < numlike; i++)
+        cout << TAB << tmpscores[i + 1];
+      cout << endl;
+    }
+
+    //JMB stop when the run has finished or the process has been killed
+    alive = ((kill(copy.pid, 0) == 0) || (errno == EPERM));
+    if ((strcmp(copy.phase, "finished") == 0) || (!alive))
+      check = 0;
+    else
+      sleep(1);
+  }
+  munmap(mapped, size);
+#else
+  cerr << "Error - Gadget cannot read a status file on this platform" << endl;
+  exit(EXIT_FAILURE);
+#endif
+}
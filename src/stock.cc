@@ -134,6 +134,7 @@ Stock::Stock(CommentStream& infile, const char* givenname,
   if (strcasecmp(text, "naturalmortality") != 0)
     handle.logFileUnexpected(LOGFAIL, "naturalmortality", text);
   naturalm = new NaturalMortality(infile, minage, numage, this->getName(), areas, TimeInfo, keeper);
+  tmpMortality.resize(numage, 0.0);
   handle.logMessage(LOGMESSAGE, "Read natural mortality data for stock", this->getName());
 
   //read the prey data
@@ -349,6 +350,11 @@ void Stock::Reset(const TimeClass* const TimeInfo) {
     initial->Initialise(Alkeys);
     if (doesrenew)
       renewal->Reset();
+  }
+
+  //JMB these are calculated from the parameters, so are also recalculated
+  //if the parameters are changed part way through the simulation
+  if (TimeInfo->didParametersChange()) {
     if (doesgrow)
       grower->Reset();
     if (doesmigrate)
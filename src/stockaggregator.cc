@@ -69,4 +69,8 @@ void StockAggregator::Sum() {
       }
     }
   }
+
+  //JMB calculate the mean weights now that the population has been summed
+  for (area = 0; area < total.Size(); area++)
+    total[area].finaliseSum();
 }
@@ -29,6 +29,7 @@ StockDistribution::StockDistribution(CommentStream& infile,
   CommentStream subdata(datafile);
 
   timeindex = 0;
+  modelindex = 0;
   yearly = 0;
   functionname = new char[MaxStrLength];
   strncpy(functionname, "", MaxStrLength);
@@ -263,12 +264,9 @@ void StockDistribution::readStockData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numstock, (numage * numlen), 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numstock, (numage * numlen), 0.0));
-        }
       }
 
     } else
@@ -314,12 +312,12 @@ StockDistribution::~StockDistribution() {
     delete modelYearData[i];
     delete obsYearData[i];
   }
-  for (i = 0; i < obsDistribution.Nrow(); i++) {
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+  for (i = 0; i < obsDistribution.Nrow(); i++)
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
+  for (i = 0; i < modelDistribution.Nrow(); i++)
+    for (j = 0; j < modelDistribution.Ncol(i); j++)
       delete modelDistribution[i][j];
-    }
-  }
 }
 
 void StockDistribution::Reset(const Keeper* const keeper) {
@@ -366,7 +364,7 @@ void StockDistribution::Print(ofstream& outfile) const {
 }
 
 void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
-  int s, i, j, k, found, minage, maxage;
+  int s, i, j, k, found, minage, maxage, numtime;
   FleetPtrVector fleets;
   StockPtrVector stocks;
   StockPtrVector checkstocks;
@@ -474,6 +472,17 @@ void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
     if (found == 0)
       handle.logMessage(LOGWARN, "Warning in stockdistribution - maximum length group greater than stock length");
   }
+
+  //JMB only store the model data for every timestep if it is going to be printed,
+  //otherwise the same matrices are used for each timestep to save memory
+  numtime = obsDistribution.Nrow();
+  if ((!printlikelihood) && (numtime > 1))
+    numtime = 1;
+  for (i = 0; i < numtime; i++) {
+    modelDistribution.resize();
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
+      modelDistribution[i].resize(new DoubleMatrix(obsDistribution[i][j]->Nrow(), obsDistribution[i][j]->Ncol(), 0.0));
+  }
 }
 
 void StockDistribution::addLikelihood(const TimeClass* const TimeInfo) {
@@ -492,6 +501,15 @@ void StockDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stockdistribution - invalid timestep");
 
+  //JMB the model data is only stored for this timestep if it is going to be printed
+  if (printlikelihood)
+    modelindex = timeindex;
+  else {
+    modelindex = 0;
+    for (i = 0; i < modelDistribution.Ncol(0); i++)
+      (*modelDistribution[0][i]).setToZero();
+  }
+
   for (i = 0; i < stocknames.Size(); i++) {
     aggregator[i]->Sum();
     if ((handle.getLogLevel() >= LOGWARN) && (aggregator[i]->checkCatchData()))
@@ -537,13 +555,13 @@ double StockDistribution::calcLikMultinomial() {
       alptr = &aggregator[s]->getSum();
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-          (*modelDistribution[timeindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
+          (*modelDistribution[modelindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
     }
 
     for (i = 0; i < (numage * numlen); i++) {
       for (s = 0; s < numstock; s++) {
         obsdata[s] = (*obsDistribution[timeindex][area])[s][i];
-        moddata[s] = (*modelDistribution[timeindex][area])[s][i];
+        moddata[s] = (*modelDistribution[modelindex][area])[s][i];
       }
       likelihoodValues[timeindex][area] += MN.calcLogLikelihood(obsdata, moddata);
     }
@@ -567,7 +585,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
       alptr = &aggregator[s]->getSum();
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-          (*modelDistribution[timeindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
+          (*modelDistribution[modelindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
     }
 
     if (!yearly) { //calculate likelihood on all steps
@@ -575,7 +593,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
         totalmodel = 0.0;
         totaldata = 0.0;
         for (s = 0; s < numstock; s++) {
-          totalmodel += (*modelDistribution[timeindex][area])[s][i];
+          totalmodel += (*modelDistribution[modelindex][area])[s][i];
           totaldata += (*obsDistribution[timeindex][area])[s][i];
         }
 
@@ -586,7 +604,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
         for (s = 0; s < numstock; s++) {
           temp = (((*obsDistribution[timeindex][area])[s][i] * totaldata)
-            - ((*modelDistribution[timeindex][area])[s][i] * totalmodel));
+            - ((*modelDistribution[modelindex][area])[s][i] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -604,7 +622,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
             i = age + (numage * len);
-            (*modelYearData[area])[s][i] += (*modelDistribution[timeindex][area])[s][i];
+            (*modelYearData[area])[s][i] += (*modelDistribution[modelindex][area])[s][i];
             (*obsYearData[area])[s][i] += (*obsDistribution[timeindex][area])[s][i];
           }
         }
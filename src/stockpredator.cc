@@ -6,6 +6,7 @@
 #include "areatime.h"
 #include "suits.h"
 #include "readword.h"
+#include "vectormath.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -85,6 +86,9 @@ StockPredator::StockPredator(CommentStream& infile, const char* givenname, const
   Phi.AddRows(numarea, numlength, 0.0);
   fphi.AddRows(numarea, numlength, 0.0);
   subfphi.AddRows(numarea, numlength, 0.0);
+  //JMB any number raised to the power 0 is 1
+  lengthPower.resize(numlength, 1.0);
+  lastPower = 0.0;
 
   keeper->clearLast();
   keeper->clearLast();
@@ -124,9 +128,43 @@ void StockPredator::Sum(const AgeBandMatrix& stockAlkeys, int area) {
 void StockPredator::Reset(const TimeClass* const TimeInfo) {
   PopPredator::Reset(TimeInfo);
 
+  int i, prey, predl, minl, maxl;
+  int numlen = LgrpDiv->numLengthGroups();
+  if (minSuitLength.Nrow() != this->numPreys()) {
+    minSuitLength.AddRows(this->numPreys(), numlen, 0);
+    maxSuitLength.AddRows(this->numPreys(), numlen, 0);
+  }
+
+  //find the range of prey lengths that have a non-zero suitability, so that
+  //the prey lengths that cannot be eaten can be skipped when calculating consumption
+  for (prey = 0; prey < this->numPreys(); prey++) {
+    //JMB the preference can change between simulations even if the suitability doesn't
+    if ((TimeInfo->didParametersChange()) || (this->didChange(prey, TimeInfo))) {
+      const DoubleMatrix& suit = this->getSuitability(prey);
+      for (predl = 0; predl < numlen; predl++) {
+        minl = 0;
+        maxl = suit.Ncol(predl);
+        //JMB check for exactly zero, since small suitabilities can still matter
+        //and zero raised to a power that isn't positive is not zero
+        if (preference[prey] > 0.0) {
+          while ((minl < maxl) && (suit[predl][minl] == 0.0))
+            minl++;
+          while ((maxl > minl) && (suit[predl][maxl - 1] == 0.0))
+            maxl--;
+        }
+        minSuitLength[prey][predl] = minl;
+        maxSuitLength[prey][predl] = maxl;
+      }
+
+      //the consumption outside this range is never set, so it needs to be reset
+      for (i = 0; i < areas.Size(); i++)
+        (*cons[i][prey]).setToZero();
+    }
+  }
+
   //check that the various parameters that can be estimated are sensible
   if ((handle.getLogLevel() >= LOGWARN) && (TimeInfo->getTime() == 1)) {
-    int i, check;
+    int check;
     if (functionnumber == 1)
       for (i = 0; i < consParam.Size(); i++)
         if (consParam[i] < 0.0)
@@ -143,9 +181,10 @@ void StockPredator::Reset(const TimeClass* const TimeInfo) {
 
 void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass* const TimeInfo) {
 
-  int prey, predl, preyl, check;
+  int prey, predl, preyl, minl, maxl, check;
   int inarea = this->areaNum(area);
-  double tmp;
+  int numlen = LgrpDiv->numLengthGroups();
+  double tmp, energy, pref;
 
   if (TimeInfo->getSubStep() == 1) {
     //this is the first substep of the timestep so need to reset things
@@ -158,8 +197,14 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
       double temperature = Area->getTemperature(area, TimeInfo->getTime());
       tmp = exp(temperature * (consParam[1] - temperature * temperature * consParam[2]))
            * consParam[0] * TimeInfo->getTimeStepLength() / TimeInfo->numSubSteps();
-      for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++)
-        maxcons[inarea][predl] = tmp * pow(LgrpDiv->meanLength(predl), consParam[3]);
+
+      //JMB only recalculate the length dependent part when the power changes
+      if (consParam[3] != lastPower) {
+        lastPower = consParam[3];
+        vpow(&lengthPower[0], &(LgrpDiv->meanLengths())[0], lastPower, numlen);
+      }
+      for (predl = 0; predl < numlen; predl++)
+        maxcons[inarea][predl] = tmp * lengthPower[predl];
 
     } else if (functionnumber == 2) {
       double max1, max2, max3, l;
@@ -185,29 +230,38 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
   //Now maxcons contains the maximum consumption by length
   //Calculating Phi(L) and O(l,L,prey) based on energy requirements
   for (prey = 0; prey < this->numPreys(); prey++) {
-    check = 0;
-    if (isEqual(preference[prey], 1.0))
-      check = 1;
+    energy = this->getPrey(prey)->getEnergy();
+    if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(energy)))) {
+      const DoubleMatrix& suit = this->getSuitability(prey);
+      const DoubleVector& biomass = this->getPrey(prey)->getBiomass(area);
+      pref = preference[prey];
+      check = 0;
+      if (isEqual(pref, 1.0))
+        check = 1;
 
-    if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(this->getPrey(prey)->getEnergy())))) {
-      for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++) {
-          tmp = this->getSuitability(prey)[predl][preyl] * this->getPrey(prey)->getEnergy()
-                  * this->getPrey(prey)->getBiomass(area, preyl);
-
-          //JMB - dont take the power if we dont have to
-          if (!check)
-            tmp = pow(tmp, preference[prey]);
-          (*cons[inarea][prey])[predl][preyl] = tmp;
-          Phi[inarea][predl] += tmp;
+      for (predl = 0; predl < numlen; predl++) {
+        DoubleVector& preycons = (*cons[inarea][prey])[predl];
+        minl = minSuitLength[prey][predl];
+        maxl = maxSuitLength[prey][predl];
+
+        //JMB dont take the power if we dont have to
+        if (check) {
+          for (preyl = minl; preyl < maxl; preyl++) {
+            tmp = suit[predl][preyl] * energy * biomass[preyl];
+            preycons[preyl] = tmp;
+            Phi[inarea][predl] += tmp;
+          }
+        } else if (minl < maxl) {
+          for (preyl = minl; preyl < maxl; preyl++)
+            preycons[preyl] = suit[predl][preyl] * energy * biomass[preyl];
+          vpow(&preycons[minl], &preycons[minl], pref, maxl - minl);
+          for (preyl = minl; preyl < maxl; preyl++)
+            Phi[inarea][predl] += preycons[preyl];
         }
       }
 
-    } else {
-      for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++)
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
-          (*cons[inarea][prey])[predl][preyl] = 0.0;
-    }
+    } else
+      (*cons[inarea][prey]).setToZero();
   }
 
   tmp = TimeInfo->getTimeStepLength() / TimeInfo->numSubSteps();
@@ -236,10 +290,11 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
   //Distributing the total consumption on the preys and converting to biomass
   for (prey = 0; prey < this->numPreys(); prey++) {
     if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(this->getPrey(prey)->getEnergy())))) {
-      for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
+      for (predl = 0; predl < numlen; predl++) {
         if (!(isZero(Phi[inarea][predl]))) {
           tmp = totalcons[inarea][predl] / (Phi[inarea][predl] * this->getPrey(prey)->getEnergy());
-          for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
+          maxl = maxSuitLength[prey][predl];
+          for (preyl = minSuitLength[prey][predl]; preyl < maxl; preyl++)
             (*cons[inarea][prey])[predl][preyl] *= tmp;
 
           //set the multiplicative constant
@@ -261,7 +316,7 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
 void StockPredator::adjustConsumption(int area, const TimeClass* const TimeInfo) {
   int inarea = this->areaNum(area);
   int numlen = LgrpDiv->numLengthGroups();
-  int preyl, predl, prey;
+  int preyl, predl, prey, maxl;
   double maxRatio, tmp;
 
   maxRatio = TimeInfo->getMaxRatioConsumed();
@@ -271,9 +326,10 @@ void StockPredator::adjustConsumption(int area, const TimeClass* const TimeInfo)
   for (prey = 0; prey < this->numPreys(); prey++) {
     if (this->getPrey(prey)->isOverConsumption(area)) {
       hasoverconsumption[inarea] = 1;
-      DoubleVector ratio = this->getPrey(prey)->getRatio(area);
+      const DoubleVector& ratio = this->getPrey(prey)->getRatio(area);
       for (predl = 0; predl < numlen; predl++) {
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++) {
+        maxl = maxSuitLength[prey][predl];
+        for (preyl = minSuitLength[prey][predl]; preyl < maxl; preyl++) {
           if (ratio[preyl] > maxRatio) {
             tmp = maxRatio / ratio[preyl];
             overcons[inarea][predl] += (1.0 - tmp) * (*cons[inarea][prey])[predl][preyl];
@@ -312,7 +368,9 @@ void StockPredator::adjustConsumption(int area, const TimeClass* const TimeInfo)
 
   for (prey = 0; prey < this->numPreys(); prey++)
     if (this->getPrey(prey)->isPreyArea(area))
-      for (predl = 0; predl < numlen; predl++)
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
+      for (predl = 0; predl < numlen; predl++) {
+        maxl = maxSuitLength[prey][predl];
+        for (preyl = minSuitLength[prey][predl]; preyl < maxl; preyl++)
           (*consumption[inarea][prey])[predl][preyl] += (*cons[inarea][prey])[predl][preyl];
+      }
 }
@@ -73,4 +73,8 @@ void StockPreyAggregator::Sum() {
       }
     }
   }
+
+  //JMB calculate the mean weights now that the population has been summed
+  for (area = 0; area < total.Size(); area++)
+    total[area].finaliseSum();
 }
@@ -89,6 +89,8 @@ SC::SC(CommentStream& infile, const AreaClass* const Area, const TimeClass* cons
   int numarea = 0;
 
   timeindex = 0;
+  modelindex = 0;
+  printlikelihood = 0;
   usepredages = 0;
 
   char aggfilename[MaxStrLength];
@@ -205,6 +207,15 @@ double SC::calcLikelihood(const TimeClass* const TimeInfo) {
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stomachcontent - invalid timestep");
 
+  //JMB the model data is only stored for this timestep if it is going to be printed
+  if (printlikelihood)
+    modelindex = timeindex;
+  else {
+    modelindex = 0;
+    for (a = 0; a < modelConsumption.Ncol(0); a++)
+      (*modelConsumption[0][a]).setToZero();
+  }
+
   //Get the consumption from aggregator, indexed the same way as in obsConsumption
   int numprey = 0;
   for (i = 0; i < preyindex.Size(); i++) {
@@ -213,7 +224,7 @@ double SC::calcLikelihood(const TimeClass* const TimeInfo) {
       dptr = aggregator[i]->getSum()[a];
       for (k = 0; k < dptr->Nrow(); k++)
         for (p = 0; p < dptr->Ncol(k); p++)
-          (*modelConsumption[timeindex][a])[k][numprey + p] = (*dptr)[k][p] * digestion[i][p];
+          (*modelConsumption[modelindex][a])[k][numprey + p] = (*dptr)[k][p] * digestion[i][p];
 
     }
     numprey += preylengths[i].Size() - 1;
@@ -293,12 +304,12 @@ void SC::printLikelihood(ofstream& outfile, const TimeClass* const TimeInfo) {
 
 SC::~SC() {
   int i, j;
-  for (i = 0; i < obsConsumption.Nrow(); i++) {
-    for (j = 0; j < obsConsumption[i].Size(); j++) {
+  for (i = 0; i < obsConsumption.Nrow(); i++)
+    for (j = 0; j < obsConsumption[i].Size(); j++)
       delete obsConsumption[i][j];
+  for (i = 0; i < modelConsumption.Nrow(); i++)
+    for (j = 0; j < modelConsumption[i].Size(); j++)
       delete modelConsumption[i][j];
-    }
-  }
 
   for (i = 0; i < preyindex.Size(); i++) {
     delete aggregator[i];
@@ -330,7 +341,7 @@ SC::~SC() {
 }
 
 void SC::setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys) {
-  int i, j, k, l, found;
+  int i, j, k, l, found, numtime;
   int minage, maxage;
   PredatorPtrVector predators;
   aggregator = new PredatorAggregator*[preyindex.Size()];
@@ -454,6 +465,17 @@ void SC::setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys
     else
       aggregator[i] = new PredatorAggregator(predators, preys, areas, predLgrpDiv, preyLgrpDiv[i]);
   }
+
+  //JMB only store the model data for every timestep if it is going to be printed,
+  //otherwise the same matrices are used for each timestep to save memory
+  numtime = obsConsumption.Nrow();
+  if ((!printlikelihood) && (numtime > 1))
+    numtime = 1;
+  for (i = 0; i < numtime; i++) {
+    modelConsumption.resize();
+    for (j = 0; j < obsConsumption.Ncol(i); j++)
+      modelConsumption[i].resize(new DoubleMatrix(obsConsumption[i][j]->Nrow(), obsConsumption[i][j]->Ncol(), 0.0));
+  }
 }
 
 void SC::Print(ofstream& outfile) const {
@@ -593,12 +615,9 @@ void SCNumbers::readStomachNumberContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-        }
       }
 
     } else
@@ -628,7 +647,7 @@ double SCNumbers::calcLikelihood() {
     for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(0); prey++) {
       for (pred = 0; pred < mndata.Size(); pred++) {
         mndata[pred] = (*obsConsumption[timeindex][a])[pred][prey];
-        mndist[pred] = (*modelConsumption[timeindex][a])[pred][prey];
+        mndist[pred] = (*modelConsumption[modelindex][a])[pred][prey];
       }
       likelihoodValues[timeindex][a] += MN.calcLogLikelihood(mndata, mndist);
     }
@@ -747,12 +766,10 @@ void SCAmounts::readStomachAmountContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         stddev.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
         for (i = 0; i < numarea; i++) {
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
           stddev[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
         }
       }
@@ -910,9 +927,9 @@ double SCAmounts::calcLikelihood() {
         tmplik = 0.0;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
           if (!(isZero((*stddev[timeindex][a])[pred][prey])))
-            tmplik += ((*modelConsumption[timeindex][a])[pred][prey] -
+            tmplik += ((*modelConsumption[modelindex][a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) *
-              ((*modelConsumption[timeindex][a])[pred][prey] -
+              ((*modelConsumption[modelindex][a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) /
               ((*stddev[timeindex][a])[pred][prey] * (*stddev[timeindex][a])[pred][prey]);
         }
@@ -959,21 +976,21 @@ double SCRatios::calcLikelihood() {
     likelihoodValues[timeindex][a] = 0.0;
     for (pred = 0; pred < obsConsumption[timeindex][a]->Nrow(); pred++) {
       scale = 0.0;
-      for (prey = 0; prey < modelConsumption[timeindex][a]->Ncol(pred); prey++)
-        scale += (*modelConsumption[timeindex][a])[pred][prey];
+      for (prey = 0; prey < modelConsumption[modelindex][a]->Ncol(pred); prey++)
+        scale += (*modelConsumption[modelindex][a])[pred][prey];
 
       if (!(isZero(scale))) {
         tmpdivide = 1.0 / scale;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++)
-          (*modelConsumption[timeindex][a])[pred][prey] *= tmpdivide;
+          (*modelConsumption[modelindex][a])[pred][prey] *= tmpdivide;
 
         if (!(isZero((*number[timeindex])[a][pred]))) {
           tmplik = 0.0;
           for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
             if (!(isZero((*stddev[timeindex][a])[pred][prey])))
-              tmplik += ((*modelConsumption[timeindex][a])[pred][prey]  -
+              tmplik += ((*modelConsumption[modelindex][a])[pred][prey]  -
                 (*obsConsumption[timeindex][a])[pred][prey]) *
-                ((*modelConsumption[timeindex][a])[pred][prey]  -
+                ((*modelConsumption[modelindex][a])[pred][prey]  -
                 (*obsConsumption[timeindex][a])[pred][prey]) /
                 ((*stddev[timeindex][a])[pred][prey] * (*stddev[timeindex][a])[pred][prey]);
           }
@@ -1085,12 +1102,9 @@ void SCSimple::readStomachSimpleContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-        }
       }
 
     } else
@@ -1143,17 +1157,17 @@ double SCSimple::calcLikelihood() {
     likelihoodValues[timeindex][a] = 0.0;
     for (pred = 0; pred < obsConsumption[timeindex][a]->Nrow(); pred++) {
       scale = 0.0;
-      for (prey = 0; prey < modelConsumption[timeindex][a]->Ncol(pred); prey++)
-        scale += (*modelConsumption[timeindex][a])[pred][prey];
+      for (prey = 0; prey < modelConsumption[modelindex][a]->Ncol(pred); prey++)
+        scale += (*modelConsumption[modelindex][a])[pred][prey];
 
       if (!(isZero(scale))) {
         tmpdivide = 1.0 / scale;
         tmplik = 0.0;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
-          (*modelConsumption[timeindex][a])[pred][prey] *= tmpdivide;
-          tmplik += ((*modelConsumption[timeindex][a])[pred][prey] -
+          (*modelConsumption[modelindex][a])[pred][prey] *= tmpdivide;
+          tmplik += ((*modelConsumption[modelindex][a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) *
-              ((*modelConsumption[timeindex][a])[pred][prey] -
+              ((*modelConsumption[modelindex][a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]);
         }
         likelihoodValues[timeindex][a] += tmplik;
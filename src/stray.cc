@@ -254,7 +254,7 @@ void StrayData::Reset(const TimeClass* const TimeInfo) {
   int i;
 
   //JMB check that the sum of the ratios is 1
-  if (TimeInfo->getTime() == 1) {
+  if (TimeInfo->didParametersChange()) {
     ratioscale = 0.0;
     for (i = 0; i < strayRatio.Size(); i++ )
       ratioscale += strayRatio[i];
@@ -28,6 +28,7 @@ SurveyDistribution::SurveyDistribution(CommentStream& infile, const AreaClass* c
   readWordAndValue(infile, "datafile", datafilename);
 
   timeindex = 0;
+  modelindex = 0;
   fittype = new char[MaxStrLength];
   strncpy(fittype, "", MaxStrLength);
   liketype = new char[MaxStrLength];
@@ -238,12 +239,9 @@ void SurveyDistribution::readDistributionData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-        }
       }
 
     } else
@@ -294,12 +292,12 @@ SurveyDistribution::~SurveyDistribution() {
     delete suitfunction;
     suitfunction = NULL;
   }
-  for (i = 0; i < obsDistribution.Nrow(); i++) {
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+  for (i = 0; i < obsDistribution.Nrow(); i++)
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
+  for (i = 0; i < modelDistribution.Nrow(); i++)
+    for (j = 0; j < modelDistribution.Ncol(i); j++)
       delete modelDistribution[i][j];
-    }
-  }
 
   if (aggregator != 0)
     delete aggregator;
@@ -364,7 +362,7 @@ void SurveyDistribution::printLikelihood(ofstream& outfile, const TimeClass* con
 
 void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
 
-  int i, j, k, found, minage, maxage;
+  int i, j, k, found, minage, maxage, numtime;
   StockPtrVector stocks;
 
   for (i = 0; i < stocknames.Size(); i++) {
@@ -435,6 +433,17 @@ void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVect
   }
 
   aggregator = new StockAggregator(stocks, LgrpDiv, areas, ages);
+
+  //JMB only store the model data for every timestep if it is going to be printed,
+  //otherwise the same matrices are used for each timestep to save memory
+  numtime = obsDistribution.Nrow();
+  if ((!printlikelihood) && (numtime > 1))
+    numtime = 1;
+  for (i = 0; i < numtime; i++) {
+    modelDistribution.resize();
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
+      modelDistribution[i].resize(new DoubleMatrix(obsDistribution[i][j]->Nrow(), obsDistribution[i][j]->Ncol(), 0.0));
+  }
 }
 
 void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
@@ -462,13 +471,13 @@ void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
       for (area = 0; area < areas.Nrow(); area++)
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-            (*modelDistribution[timeindex][area])[age][len] = parameters[0] * suit[len] * (((*alptr)[area][age][len]).N + parameters[1]);
+            (*modelDistribution[modelindex][area])[age][len] = parameters[0] * suit[len] * (((*alptr)[area][age][len]).N + parameters[1]);
       break;
     case 2:
       for (area = 0; area < areas.Nrow(); area++)
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-            (*modelDistribution[timeindex][area])[age][len] = parameters[0] * suit[len] * pow(((*alptr)[area][age][len]).N, parameters[1]);
+            (*modelDistribution[modelindex][area])[age][len] = parameters[0] * suit[len] * pow(((*alptr)[area][age][len]).N, parameters[1]);
       break;
     default:
       handle.logMessage(LOGWARN, "Warning in surveydistribution - unrecognised fittype", fittype);
@@ -489,6 +498,15 @@ void SurveyDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveydistribution - invalid timestep");
 
+  //JMB the model data is only stored for this timestep if it is going to be printed
+  if (printlikelihood)
+    modelindex = timeindex;
+  else {
+    modelindex = 0;
+    for (i = 0; i < modelDistribution.Ncol(0); i++)
+      (*modelDistribution[0][i]).setToZero();
+  }
+
   double l = 0.0;
   aggregator->Sum();
   if (handle.getLogLevel() >= LOGMESSAGE)
@@ -534,9 +552,9 @@ double SurveyDistribution::calcLikMultinomial() {
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
         temp -= (*obsDistribution[timeindex][area])[age][len] *
-                 log(((*modelDistribution[timeindex][area])[age][len]) + epsilon);
+                 log(((*modelDistribution[modelindex][area])[age][len]) + epsilon);
         obstotal += (*obsDistribution[timeindex][area])[age][len];
-        modtotal += ((*modelDistribution[timeindex][area])[age][len] + epsilon);
+        modtotal += ((*modelDistribution[modelindex][area])[age][len] + epsilon);
       }
     }
 
@@ -563,9 +581,9 @@ double SurveyDistribution::calcLikPearson() {
     temp = 0.0;
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
-        diff = ((*modelDistribution[timeindex][area])[age][len] - (*obsDistribution[timeindex][area])[age][len]);
+        diff = ((*modelDistribution[modelindex][area])[age][len] - (*obsDistribution[timeindex][area])[age][len]);
         diff *= diff;
-        diff /= ((*modelDistribution[timeindex][area])[age][len] + epsilon);
+        diff /= ((*modelDistribution[modelindex][area])[age][len] + epsilon);
         temp += diff;
       }
     }
@@ -589,8 +607,8 @@ double SurveyDistribution::calcLikGamma() {
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++)
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++)
         temp += (((*obsDistribution[timeindex][area])[age][len] /
-                 ((*modelDistribution[timeindex][area])[age][len] + epsilon)) +
-                 log((*modelDistribution[timeindex][area])[age][len] + epsilon));
+                 ((*modelDistribution[modelindex][area])[age][len] + epsilon)) +
+                 log((*modelDistribution[modelindex][area])[age][len] + epsilon));
 
     likelihoodValues[timeindex][area] = temp;
     total += likelihoodValues[timeindex][area];
@@ -609,7 +627,7 @@ double SurveyDistribution::calcLikLog() {
     modtotal = 0.0;
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
-        modtotal += (*modelDistribution[timeindex][area])[age][len];
+        modtotal += (*modelDistribution[modelindex][area])[age][len];
         obstotal += (*obsDistribution[timeindex][area])[age][len];
       }
     }
@@ -192,17 +192,8 @@ Tags::~Tags() {
 }
 
 void Tags::Reset() {
+  //JMB the storage for the tagged population is kept, and will be refilled by Update()
   int i;
-  while (AgeLengthStock.Nrow() > 0)
-    AgeLengthStock.Delete(0);
-  while (NumBeforeEating.Nrow() > 0)
-    NumBeforeEating.Delete(0);
-  while (CI.Size() > 0) {
-    delete CI[0];
-    CI.Delete(0);
-  }
-  for (i = 0; i < preyindex.Size(); i++)
-    preyindex[i] = -1;
   for (i = 0; i < updated.Size(); i++)
     updated[i] = 0;
 }
@@ -273,6 +264,58 @@ void Tags::setStock(StockPtrVector& Stocks) {
     strcpy(stockname, tagStocks[i]->getName());
     stocknames.resize(stockname);
   }
+  this->setStorage();
+}
+
+//The storage for the tagged population only depends on the structure of the stocks,
+//so it is created once when the stocks are set and reused for each simulation
+void Tags::setStorage() {
+  int i, j;
+  const AgeBandMatrix* stockPopInArea;
+  const LengthGroupDivision* tmpLgrpDiv;
+  IntVector stockareas;
+  int numareas, maxage, minage, numberofagegroups, upperlgrp, stockid;
+  IntVector lgrpsize;
+  IntVector lgrpmin;
+
+  //We must make AgeBandMatrixPtrVector same size as the one in stock
+  //even though have only one area entry at the beginning
+  for (i = 0; i < tagStocks.Size(); i++) {
+    stockPopInArea = &tagStocks[i]->getCurrentALK(tagarea);
+    stockareas = tagStocks[i]->getAreas();
+    numareas = stockareas.Size();
+    maxage = stockPopInArea->maxAge();
+    minage = stockPopInArea->minAge();
+    numberofagegroups = maxage - minage + 1;
+    lgrpmin.Reset();
+    lgrpsize.Reset();
+    lgrpmin.resize(numberofagegroups, 0);
+    lgrpsize.resize(numberofagegroups, 0);
+    for (j = 0; j < numberofagegroups; j++) {
+      lgrpmin[j] = stockPopInArea->minLength(j + minage);
+      upperlgrp = stockPopInArea->maxLength(j + minage);
+      lgrpsize[j] = upperlgrp - lgrpmin[j];
+    }
+
+    AgeLengthStock.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
+    if (tagStocks[i]->isEaten()) {
+      tmpLgrpDiv = tagStocks[i]->getPrey()->getLengthGroupDiv();
+      lgrpmin.Reset();
+      lgrpsize.Reset();
+      lgrpmin.resize(numberofagegroups, 0);
+      lgrpsize.resize(numberofagegroups, tmpLgrpDiv->numLengthGroups());
+      NumBeforeEating.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
+      CI.resize(new ConversionIndex(LgrpDiv, tmpLgrpDiv));
+      if (CI[CI.Size() - 1]->Error())
+        handle.logMessage(LOGFAIL, "Error in tags - error when checking length structure");
+
+      stockid = stockIndex(tagStocks[i]->getName());
+      if (stockid < 0 || stockid >= preyindex.Size())
+        handle.logMessage(LOGFAIL, "Error in tags - invalid stock identifier");
+
+      preyindex[stockid] = NumBeforeEating.Nrow() - 1;
+    }
+  }
 }
 
 //Must have set stocks according to stocknames using setStock before calling Update()
@@ -283,16 +326,17 @@ void Tags::Update(int timeid) {
   NumberInArea.resizeBlank(LgrpDiv->numLengthGroups());
 
   const AgeBandMatrix* stockPopInArea;
-  const LengthGroupDivision* tmpLgrpDiv;
-
   stockPopInArea = &(taggingstock->getCurrentALK(tagarea));
   stockPopInArea->sumColumns(NumberInArea);
 
   //Now we have total number of stock per length in tagarea, N(., l) (NumberInArea) and
-  //number of stock per age/length, N(a, l) (stockPopInArea) so we must initialise
-  //AgeLengthStock so that it can hold all information of number of tagged stock
-  //per area/age/length after endtime. We must make AgeBandMatrixPtrVector same size as
-  //the one in stock even though have only one area entry at the beginning
+  //number of stock per age/length, N(a, l) (stockPopInArea) so we must fill
+  //AgeLengthStock so that it holds all information of number of tagged stock
+  //per area/age/length after endtime, starting from no tagged fish in any stock
+  for (i = 0; i < AgeLengthStock.Nrow(); i++)
+    for (j = 0; j < AgeLengthStock.Ncol(i); j++)
+      (*AgeLengthStock[i])[j].setToZero();
+
   IntVector stockareas = taggingstock->getAreas();
   int numareas = stockareas.Size();
   int tagareaindex = -1;
@@ -307,19 +351,9 @@ void Tags::Update(int timeid) {
 
   int maxage = stockPopInArea->maxAge();
   int minage = stockPopInArea->minAge();
-  int numberofagegroups = maxage - minage + 1;
-  int upperlgrp, minl, maxl, age, length, stockid;
+  int minl, maxl, age, length;
   double numfishinarea, numstockinarea;
-  IntVector lgrpsize(numberofagegroups, 0);
-  IntVector lgrpmin(numberofagegroups, 0);
-
-  for (i = 0; i < numberofagegroups; i++) {
-    lgrpmin[i]= stockPopInArea->minLength(i + minage);
-    upperlgrp = stockPopInArea->maxLength(i + minage);
-    lgrpsize[i] = upperlgrp - lgrpmin[i];
-  }
 
-  AgeLengthStock.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
   for (age = minage; age <= maxage; age++) {
     minl = stockPopInArea->minLength(age);
     maxl = stockPopInArea->maxLength(age);
@@ -334,61 +368,6 @@ void Tags::Update(int timeid) {
   }
   taggingstock->addTags(AgeLengthStock[0], this, exp(-tagloss));
   updated[0] = 1;
-
-  if (taggingstock->isEaten()) {
-    tmpLgrpDiv = taggingstock->getPrey()->getLengthGroupDiv();
-    lgrpmin.Reset();
-    lgrpsize.Reset();
-    lgrpmin.resize(numberofagegroups, 0);
-    lgrpsize.resize(numberofagegroups, tmpLgrpDiv->numLengthGroups());
-    NumBeforeEating.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
-    CI.resize(new ConversionIndex(LgrpDiv, tmpLgrpDiv));
-    if (CI[CI.Size() - 1]->Error())
-      handle.logMessage(LOGFAIL, "Error in tags - error when checking length structure");
-
-    stockid = stockIndex(taggingstock->getName());
-    if (stockid < 0 || stockid >= preyindex.Size())
-      handle.logMessage(LOGFAIL, "Error in tags - invalid stock identifier");
-
-    preyindex[stockid] = NumBeforeEating.Nrow() - 1;
-  }
-
-  for (i = 1; i < tagStocks.Size(); i++) {
-    stockPopInArea = &tagStocks[i]->getCurrentALK(tagarea);
-    stockareas = tagStocks[i]->getAreas();
-    numareas = stockareas.Size();
-    maxage = stockPopInArea->maxAge();
-    minage = stockPopInArea->minAge();
-    numberofagegroups = maxage - minage + 1;
-    lgrpmin.Reset();
-    lgrpsize.Reset();
-    lgrpmin.resize(numberofagegroups, 0);
-    lgrpsize.resize(numberofagegroups, 0);
-    for (j = 0; j < numberofagegroups; j++) {
-      lgrpmin[j] = stockPopInArea->minLength(j + minage);
-      upperlgrp = stockPopInArea->maxLength(j + minage);
-      lgrpsize[j] = upperlgrp - lgrpmin[j];
-    }
-
-    AgeLengthStock.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
-    if (tagStocks[i]->isEaten()) {
-      tmpLgrpDiv = tagStocks[i]->getPrey()->getLengthGroupDiv();
-      lgrpmin.Reset();
-      lgrpsize.Reset();
-      lgrpmin.resize(numberofagegroups, 0);
-      lgrpsize.resize(numberofagegroups, tmpLgrpDiv->numLengthGroups());
-      NumBeforeEating.resize(new AgeBandMatrixPtrVector(numareas, minage, lgrpmin, lgrpsize));
-      CI.resize(new ConversionIndex(LgrpDiv, tmpLgrpDiv));
-      if (CI[CI.Size() - 1]->Error())
-        handle.logMessage(LOGFAIL, "Error in tags - error when checking length structure");
-
-      stockid = stockIndex(tagStocks[i]->getName());
-      if (stockid < 0 || stockid >= preyindex.Size())
-        handle.logMessage(LOGFAIL, "Error in tags - invalid stock identifier");
-
-      preyindex[stockid] = NumBeforeEating.Nrow() - 1;
-    }
-  }
 }
 
 void Tags::updateTags(int year, int step) {
@@ -487,7 +466,7 @@ int Tags::areaIndex(const char* stockname, int area) {
   int i, j;
   for (i = 0; i < tagStocks.Size(); i++) {
     if (strcasecmp(stockname, tagStocks[i]->getName()) == 0) {
-      IntVector stockareas = tagStocks[i]->getAreas();
+      const IntVector& stockareas = tagStocks[i]->getAreas();
       for (j = 0; j < stockareas.Size(); j++)
         if (stockareas[j] == area)
           return j;
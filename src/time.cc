@@ -51,10 +51,27 @@ TimeClass::TimeClass(CommentStream& infile, double maxratio) {
   currentyear = firstyear;
   currentstep = firststep;
   currentsubstep = 1;
+  paramchanged = 0;
   handle.logMessage(LOGMESSAGE, "Read time file - number of timesteps", this->numTotalSteps());
 }
 
+void TimeClass::removeSubSteps() {
+  int i;
+  for (i = 0; i < numtimesteps; i++)
+    numsubsteps[i] = 1;
+  handle.logMessage(LOGMESSAGE, "Removed substeps from the timesteps for the model without substeps");
+}
+
+int TimeClass::hasSubSteps() const {
+  int i;
+  for (i = 0; i < numtimesteps; i++)
+    if (numsubsteps[i] > 1)
+      return 1;
+  return 0;
+}
+
 void TimeClass::IncrementTime() {
+  paramchanged = 0;
   if (currentyear == lastyear && currentstep == laststep) {
     if (handle.getLogLevel() >= LOGMESSAGE)
       handle.logMessage(LOGMESSAGE, "\nThe simulation has reached the last timestep for the current model run");
@@ -85,6 +102,9 @@ int TimeClass::isWithinPeriod(int year, int step) const {
 }
 
 int TimeClass::didStepSizeChange() const {
+  //JMB the first timestep follows the last timestep of the previous simulation
+  if (this->getTime() == 1)
+    return (timesteps[firststep] != timesteps[laststep]);
   if (currentstep == 1)
     return (timesteps[1] != timesteps[numtimesteps]);
   return (timesteps[currentstep] != timesteps[currentstep - 1]);
@@ -94,6 +114,7 @@ void TimeClass::Reset() {
   currentyear = firstyear;
   currentstep = firststep;
   currentsubstep = 1;
+  paramchanged = 0;
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "\nReset time in the simulation to timestep", this->getTime());
 }
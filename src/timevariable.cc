@@ -47,30 +47,71 @@ void TimeVariable::read(CommentStream& infile,
 
   if (check == -1)
     handle.logMessage(LOGFAIL, "Error in timevariable - nothing specified for first timestep of the simulation");
+
+  this->keeper = keeper;
+  timevalues.resize(TimeInfo->numTotalSteps(), 0.0);
+  timechanged.resize(TimeInfo->numTotalSteps(), 0);
 }
 
 int TimeVariable::didChange(const TimeClass* const TimeInfo) {
   if (TimeInfo->getTime() == 1)
     return 1;  //return true for the first timestep
 
-  return ((!(isEqual(lastvalue, value))) && (time == TimeInfo->getTime()));
+  return ((changed) && (time == TimeInfo->getTime()));
 }
 
 void TimeVariable::Update(const TimeClass* const TimeInfo) {
-  if (TimeInfo->getTime() == 1)
-    timeid = 0;
+  int rebuilt = 0;
+  int lasttime = time;
+  time = TimeInfo->getTime();
+  //JMB the values only need to be calculated again when the parameters have changed
+  if ((keeper == 0) || (keeper->numUpdates() != numupdates)) {
+    this->setTimeValues(TimeInfo);
+    rebuilt = 1;
+  }
 
-  int i;
-  for (i = timeid; i < steps.Size(); i++) {
-    if (steps[i] == TimeInfo->getStep() && years[i] == TimeInfo->getYear()) {
-      timeid = i;
-      time = TimeInfo->getTime();
-      break;
+  lastvalue = value;
+  value = timevalues[time - 1];
+  changed = timechanged[time - 1];
+  //JMB the parameters might have changed part way through the simulation
+  if (((rebuilt) || (lasttime != time - 1)) && (time > 1))
+    changed = !(isEqual(lastvalue, value));
+}
+
+void TimeVariable::setTimeValues(const TimeClass* const TimeInfo) {
+  int i, t;
+  int numtimes = TimeInfo->numTotalSteps();
+  if (timevalues.Size() != numtimes) {
+    timevalues.Reset();
+    timechanged.Reset();
+    timevalues.resize(numtimes, 0.0);
+    timechanged.resize(numtimes, 0);
+  }
+
+  //JMB each value is used from the timestep it is given for until the next value
+  for (t = 0; t < numtimes; t++)
+    timechanged[t] = 0;
+  for (i = 0; i < years.Size(); i++) {
+    if ((steps[i] < 1) || (steps[i] > TimeInfo->numSteps()))
+      continue;
+    t = TimeInfo->calcSteps(years[i], steps[i]) - 1;
+    if ((t >= 0) && (t < numtimes)) {
+      timevalues[t] = values[i];
+      timechanged[t] = 1;
     }
   }
 
-  lastvalue = value;
-  value = values[timeid];
+  //JMB there is always a value given for the first timestep of the simulation
+  for (t = 1; t < numtimes; t++) {
+    if (timechanged[t])
+      timechanged[t] = !(isEqual(timevalues[t - 1], timevalues[t]));
+    else
+      timevalues[t] = timevalues[t - 1];
+  }
+  timechanged[0] = 1;
+
+  if (keeper != 0)
+    numupdates = keeper->numUpdates();
 }
 
 void TimeVariable::Delete(Keeper* const keeper) const {
@@ -83,10 +124,14 @@ void TimeVariable::Interchange(TimeVariable& newTV, Keeper* const keeper) const
   int i;
   newTV.value = value;
   newTV.lastvalue = lastvalue;
-  newTV.timeid = timeid;
   newTV.time = time;
+  newTV.changed = changed;
   newTV.years = years;
   newTV.steps = steps;
+  newTV.timevalues = timevalues;
+  newTV.timechanged = timechanged;
+  newTV.keeper = keeper;
+  newTV.numupdates = -1;
   newTV.values.resize(values.Size(), keeper);
   for (i = 0; i < steps.Size(); i++)
     values[i].Interchange(newTV.values[i], keeper);
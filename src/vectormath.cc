@@ -0,0 +1,203 @@
+#include "vectormath.h"
+#include "mathfunc.h"
+#include "gadget.h"
+
+//JMB the fast versions of the functions are written as simple loops with no
+//branches so that the compiler can vectorise them, and any values that are
+//outside the range of the fast versions are then recalculated using libm
+
+static int fastmath = 0;
+
+//JMB the arrays are processed in blocks so that the temporary storage is on the stack
+static const int blocksize = 64;
+
+static const double ln2hi = 6.93147180369123816490e-01;
+static const double ln2lo = 1.90821492927058770002e-10;
+static const double invln2 = 1.44269504088896338700e+00;
+static const double sqrt2 = 1.41421356237309514547e+00;
+static const double halflog2pi = 9.18938533204672669541e-01;
+static const double magic = 6755399441055744.0;         /* 1.5 * 2^52 */
+static const double twop52 = 4503599627370496.0;        /* 2^52 */
+static const double minexp = -708.0;
+static const double maxexp = 709.0;
+static const double minnormal = 2.2250738585072014e-308;
+static const double maxnormal = 1.7976931348623157e+308;
+static const double maxgamma = 1e+300;
+
+static inline unsigned long long toBits(double a) {
+  unsigned long long b;
+  memcpy(&b, &a, sizeof(double));
+  return b;
+}
+
+static inline double fromBits(unsigned long long b) {
+  double a;
+  memcpy(&a, &b, sizeof(double));
+  return a;
+}
+
+//JMB only valid for arguments in the range minexp to maxexp
+static inline double fastExp(double a) {
+  double k, r, p;
+  unsigned long long n;
+
+  //JMB round a / log(2) to the nearest integer k, then a = k * log(2) + r
+  k = a * invln2 + magic;
+  n = toBits(k) - toBits(magic);
+  k -= magic;
+  r = (a - k * ln2hi) - k * ln2lo;
+
+  //JMB Taylor series for exp(r), where |r| < 0.35
+  p = 1.0 / 6227020800.0;
+  p = p * r + 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r * r + r;
+  p += 1.0;
+
+  //JMB multiply by 2^k by constructing the exponent directly
+  return p * fromBits((n + 1023) << 52);
+}
+
+//JMB only valid for positive normal arguments
+static inline double fastLog(double a) {
+  double e, m, f, s, z, p;
+  unsigned long long b, big;
+
+  //JMB split a into 2^e * m, where m is in the range sqrt(0.5) to sqrt(2)
+  b = (toBits(a) & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+  big = (toBits(sqrt2) - b) >> 63;
+  e = fromBits(((toBits(a) >> 52) + big) | toBits(twop52)) - twop52 - 1023.0;
+  m = fromBits(b - (big << 52));
+
+  //JMB log(m) = 2 * atanh(s), where s = (m - 1) / (m + 1) and |s| < 0.172
+  f = m - 1.0;
+  s = f / (2.0 + f);
+  z = s * s;
+  p = 1.0 / 23.0;
+  p = p * z + 1.0 / 21.0;
+  p = p * z + 1.0 / 19.0;
+  p = p * z + 1.0 / 17.0;
+  p = p * z + 1.0 / 15.0;
+  p = p * z + 1.0 / 13.0;
+  p = p * z + 1.0 / 11.0;
+  p = p * z + 1.0 / 9.0;
+  p = p * z + 1.0 / 7.0;
+  p = p * z + 1.0 / 5.0;
+  p = p * z + 1.0 / 3.0;
+  p = p * z;
+  return e * ln2hi + (f - (s * (f - 2.0 * p) - e * ln2lo));
+}
+
+void setFastMath(int flag) {
+  fastmath = flag;
+}
+
+int getFastMath() {
+  return fastmath;
+}
+
+void vexp(double* y, const double* x, int n) {
+  int i, j, num;
+  double tmp[blocksize];
+
+  if (!fastmath) {
+    for (i = 0; i < n; i++)
+      y[i] = exp(x[i]);
+    return;
+  }
+
+  for (j = 0; j < n; j += blocksize) {
+    num = min(blocksize, n - j);
+    for (i = 0; i < num; i++)
+      tmp[i] = fastExp(x[j + i]);
+    for (i = 0; i < num; i++)
+      y[j + i] = ((x[j + i] >= minexp) && (x[j + i] <= maxexp) ? tmp[i] : exp(x[j + i]));
+  }
+}
+
+void vlog(double* y, const double* x, int n) {
+  int i, j, num;
+  double tmp[blocksize];
+
+  if (!fastmath) {
+    for (i = 0; i < n; i++)
+      y[i] = log(x[i]);
+    return;
+  }
+
+  for (j = 0; j < n; j += blocksize) {
+    num = min(blocksize, n - j);
+    for (i = 0; i < num; i++)
+      tmp[i] = fastLog(x[j + i]);
+    for (i = 0; i < num; i++)
+      y[j + i] = ((x[j + i] >= minnormal) && (x[j + i] <= maxnormal) ? tmp[i] : log(x[j + i]));
+  }
+}
+
+void vpow(double* y, const double* x, double p, int n) {
+  int i, j, num;
+  double tmp[blocksize], res[blocksize];
+
+  if (!fastmath) {
+    for (i = 0; i < n; i++)
+      y[i] = pow(x[i], p);
+    return;
+  }
+
+  for (j = 0; j < n; j += blocksize) {
+    num = min(blocksize, n - j);
+    for (i = 0; i < num; i++)
+      tmp[i] = p * fastLog(x[j + i]);
+    for (i = 0; i < num; i++)
+      res[i] = fastExp(tmp[i]);
+    for (i = 0; i < num; i++)
+      y[j + i] = ((x[j + i] >= minnormal) && (x[j + i] <= maxnormal) && (tmp[i] >= minexp) && (tmp[i] <= maxexp)
+        ? res[i] : pow(x[j + i], p));
+  }
+}
+
+void vlgamma(double* y, const double* x, int n) {
+  int i, j, k, num;
+  double z, w, prod, step, tmp[blocksize];
+
+  if (!fastmath) {
+    for (i = 0; i < n; i++)
+      y[i] = lgamma(x[i]);
+    return;
+  }
+
+  for (j = 0; j < n; j += blocksize) {
+    num = min(blocksize, n - j);
+    for (i = 0; i < num; i++) {
+      //JMB use lgamma(z) = lgamma(z + 10) - log(z * (z + 1) * ... * (z + 9)) to move z above 10
+      z = x[j + i];
+      step = (z < 10.0 ? 1.0 : 0.0);
+      prod = 1.0;
+      for (k = 0; k < 10; k++)
+        prod *= (z + k) * step + (1.0 - step);
+      z += 10.0 * step;
+
+      //JMB Stirling series for lgamma(z), where z is at least 10
+      w = 1.0 / (z * z);
+      tmp[i] = 1.0 / 156.0;
+      tmp[i] = tmp[i] * w - 691.0 / 360360.0;
+      tmp[i] = tmp[i] * w + 1.0 / 1188.0;
+      tmp[i] = tmp[i] * w - 1.0 / 1680.0;
+      tmp[i] = tmp[i] * w + 1.0 / 1260.0;
+      tmp[i] = tmp[i] * w - 1.0 / 360.0;
+      tmp[i] = tmp[i] * w + 1.0 / 12.0;
+      tmp[i] = (z - 0.5) * fastLog(z) - z + halflog2pi + tmp[i] / z - fastLog(prod);
+    }
+    for (i = 0; i < num; i++)
+      y[j + i] = ((x[j + i] >= minnormal) && (x[j + i] <= maxgamma) ? tmp[i] : lgamma(x[j + i]));
+  }
+}